@@ -2,11 +2,16 @@
 #define FUNDAMENTAL_ALGORITHMS_2_LIST_H
 
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <utility>
 
 #include "../../container.h"
 
 namespace my_container {
-    template<typename T>
+    // Nodes come from Allocator rebound to the node type, so a
+    // std::pmr::polymorphic_allocator puts the whole list on its resource.
+    template<typename T, typename Allocator = std::allocator<T>>
     class List : public Container<T> {
     private:
         struct Node {
@@ -14,26 +19,75 @@ namespace my_container {
             Node *prev;
             Node *next;
             explicit Node(const T& val = T(), Node* p = nullptr, Node* n = nullptr) : data(val), prev(p), next(n) {}
+            Node(T&& val, Node* p, Node* n) : data(std::move(val)), prev(p), next(n) {}
         };
 
+        using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+        using NodeTraits = std::allocator_traits<NodeAllocator>;
+
         Node *head;
         Node *tail;
 
         size_t list_size {};
+        [[no_unique_address]] NodeAllocator alloc;
+
+        template<typename U>
+        Node* create_node(U&& value, Node* prev, Node* next) {
+            Node* node = NodeTraits::allocate(alloc, 1);
+            try {
+                NodeTraits::construct(alloc, node, std::forward<U>(value), prev, next);
+            } catch (...) {
+                NodeTraits::deallocate(alloc, node, 1);
+                throw;
+            }
+            return node;
+        }
+
+        void destroy_node(Node* node) {
+            NodeTraits::destroy(alloc, node);
+            NodeTraits::deallocate(alloc, node, 1);
+        }
+
+        template<typename U>
+        Node* link_node(Node* current, U&& value) {
+            Node* newNode = create_node(std::forward<U>(value), current ? current->prev : tail, current);
+            if (newNode->prev) {
+                newNode->prev->next = newNode;
+            } else {
+                head = newNode;
+            }
+            if (newNode->next) {
+                newNode->next->prev = newNode;
+            } else {
+                tail = newNode;
+            }
+            list_size++;
+            return newNode;
+        }
 
     public:
+        using allocator_type = Allocator;
+
         List() : head(nullptr), tail(nullptr), list_size(0) {}
-        List(const std::initializer_list<T> init) : List() {
+        explicit List(const Allocator& allocator) : head(nullptr), tail(nullptr), list_size(0), alloc(allocator) {}
+        List(const std::initializer_list<T> init, const Allocator& allocator = Allocator()) : List(allocator) {
             for (const auto &item : init) {
                 push_back(item);
             }
         }
-        List(const List& other) : List() {
+        List(const List& other)
+                : List(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {
             for (const auto &item : other) {
                 push_back(item);
             }
         }
-        List(List&& other) noexcept : head(other.head), tail(other.tail), list_size(other.list_size) {
+        List(const List& other, const Allocator& allocator) : List(allocator) {
+            for (const auto &item : other) {
+                push_back(item);
+            }
+        }
+        List(List&& other) noexcept
+                : head(other.head), tail(other.tail), list_size(other.list_size), alloc(std::move(other.alloc)) {
             other.head = nullptr;
             other.tail = nullptr;
             other.list_size = 0;
@@ -43,17 +97,37 @@ namespace my_container {
             clear();
         }
 
+        allocator_type get_allocator() const { return Allocator(alloc); }
+
         virtual List& operator=(const List& other) {
             if (this != &other) {
-                List temp(other);
+                if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+                    if (alloc != other.alloc)
+                        clear();
+                    alloc = other.alloc;
+                }
+                List temp(other, get_allocator());
                 swap(temp);
             }
             return *this;
         }
 
-        virtual List& operator=(List&& other) noexcept {
+        // Nodes from an unequal allocator that does not propagate cannot be
+        // taken over, so each element is moved into a node of this list's own
+        // allocator, as std::list does.
+        virtual List& operator=(List&& other) noexcept(NodeTraits::propagate_on_container_move_assignment::value ||
+                                                       NodeTraits::is_always_equal::value) {
             if (this != &other) {
+                if (!NodeTraits::propagate_on_container_move_assignment::value && alloc != other.alloc) {
+                    clear();
+                    for (T& item : other)
+                        push_back(std::move(item));
+                    other.clear();
+                    return *this;
+                }
                 clear();
+                if constexpr (NodeTraits::propagate_on_container_move_assignment::value)
+                    alloc = std::move(other.alloc);
                 head = other.head;
                 tail = other.tail;
                 list_size = other.list_size;
@@ -177,20 +251,11 @@ namespace my_container {
         }
 
         iterator insert(iterator pos, const T& value) {
-            Node* current = pos.ptr;
-            Node* newNode = new Node(value, current ? current->prev : tail, current);
-            if (newNode->prev) {
-                newNode->prev->next = newNode;
-            } else {
-                head = newNode;
-            }
-            if (newNode->next) {
-                newNode->next->prev = newNode;
-            } else {
-                tail = newNode;
-            }
-            list_size++;
-            return iterator(newNode);
+            return iterator(link_node(pos.ptr, value));
+        }
+
+        iterator insert(iterator pos, T&& value) {
+            return iterator(link_node(pos.ptr, std::move(value)));
         }
 
         iterator erase(iterator pos) {
@@ -207,7 +272,7 @@ namespace my_container {
             } else {
                 tail = current->prev;
             }
-            delete current;
+            destroy_node(current);
             list_size--;
             return iterator(nextNode);
         }
@@ -216,6 +281,10 @@ namespace my_container {
             insert(end(), value);
         }
 
+        void push_back(T&& value) {
+            insert(end(), std::move(value));
+        }
+
         void pop_back() {
             erase(iterator(tail));
         }
@@ -234,6 +303,8 @@ namespace my_container {
         }
 
         void swap(List& other) noexcept {
+            if constexpr (NodeTraits::propagate_on_container_swap::value)
+                std::swap(alloc, other.alloc);
             std::swap(head, other.head);
             std::swap(tail, other.tail);
             std::swap(list_size, other.list_size);
@@ -257,6 +328,11 @@ namespace my_container {
             return std::lexicographical_compare_three_way(cbegin(), cend(), other.cbegin(), other.cend());
         }
     };
+
+    namespace pmr {
+        template<typename T>
+        using List = my_container::List<T, std::pmr::polymorphic_allocator<T>>;
+    }
 }
 
 #endif //FUNDAMENTAL_ALGORITHMS_2_LIST_H
@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <initializer_list>
 #include "../include/list.h"
+#include <memory_resource>
 
 using namespace my_container;
 
@@ -175,6 +176,57 @@ TEST_F(ListTest, Comparisons) {
     EXPECT_TRUE(sampleList > shorter);
 }
 
+TEST(ListAllocatorTest, PmrListStaysOnItsResource) {
+    std::byte buffer[4096];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof buffer, std::pmr::null_memory_resource());
+
+    pmr::List<int> list({1, 2, 3}, &resource);
+    for (int i = 4; i <= 50; ++i)
+        list.push_back(i);
+    EXPECT_EQ(list.size(), 50);
+    EXPECT_EQ(list.back(), 50);
+    EXPECT_EQ(list.get_allocator().resource(), &resource);
+
+    pmr::List<int> copy;
+    copy = list;
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_TRUE(copy == list);
+
+    copy = std::move(list);
+    EXPECT_EQ(copy.size(), 50);
+    EXPECT_TRUE(list.empty());
+}
+
+namespace {
+    struct Counted {
+        static inline int copied = 0;
+
+        int value;
+
+        explicit Counted(int v) : value(v) {}
+        Counted(const Counted& other) : value(other.value) { copied++; }
+        Counted(Counted&& other) noexcept : value(other.value) {}
+        Counted& operator=(const Counted&) = default;
+        auto operator<=>(const Counted&) const = default;
+    };
+}
+
+TEST(ListAllocatorTest, MoveAcrossResourcesMovesElements) {
+    std::pmr::monotonic_buffer_resource first, second;
+    pmr::List<Counted> source(&first), target(&second);
+    for (int i = 0; i < 10; ++i)
+        source.push_back(Counted(i));
+    target.push_back(Counted(-1));
+
+    Counted::copied = 0;
+    target = std::move(source);
+    EXPECT_EQ(Counted::copied, 0);
+    EXPECT_EQ(target.size(), 10);
+    EXPECT_EQ(target.back().value, 9);
+    EXPECT_EQ(target.get_allocator().resource(), &second);
+    EXPECT_TRUE(source.empty());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -6,27 +6,31 @@
 
 namespace my_container {
 
-    template <typename T>
-    class Deque : public List<T> {
+    template <typename T, typename Allocator = std::allocator<T>>
+    class Deque : public List<T, Allocator> {
+        using Base = List<T, Allocator>;
+
     public:
-        using List<T>::operator=;
+        using Base::operator=;
 
         Deque() = default;
-        Deque(std::initializer_list<T> init) : List<T>(init) {}
-        explicit Deque(const List<T>& other) : List<T>(other) {}
-        explicit Deque(List<T>&& other) noexcept : List<T>(std::move(other)) {}
+        explicit Deque(const Allocator& allocator) : Base(allocator) {}
+        Deque(std::initializer_list<T> init, const Allocator& allocator = Allocator()) : Base(init, allocator) {}
+        explicit Deque(const Base& other) : Base(other) {}
+        Deque(const Base& other, const Allocator& allocator) : Base(other, allocator) {}
+        explicit Deque(Base&& other) noexcept : Base(std::move(other)) {}
 
-        List<T>& operator=(const List<T>& other) override {
-            List<T>::operator=(other);
+        Base& operator=(const Base& other) override {
+            Base::operator=(other);
             return *this;
         }
 
-        List<T>& operator=(List<T>&& other) noexcept override {
-            List<T>::operator=(std::move(other));
+        Base& operator=(Base&& other) noexcept(std::is_nothrow_move_assignable_v<Base>) override {
+            Base::operator=(std::move(other));
             return *this;
         }
 
-        List<T>& operator=(std::initializer_list<T> init) {
+        Base& operator=(std::initializer_list<T> init) {
             this->clear();
             for (const auto& item : init) {
                 this->push_back(item);
@@ -52,6 +56,10 @@ namespace my_container {
         const T& operator[](size_t pos) const { return at(pos); }
     };
 
+    namespace pmr {
+        template<typename T>
+        using Deque = my_container::Deque<T, std::pmr::polymorphic_allocator<T>>;
+    }
 }
 
 #endif //FUNDAMENTAL_ALGORITHMS_2_DEQUE_H
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <vector>
+#include <memory_resource>
 
 using namespace my_container;
 
@@ -109,6 +110,17 @@ TEST_F(DequeTest, RangeBasedForLoop) {
     EXPECT_EQ(values, std::vector<int>({10, 20, 30, 40, 50}));
 }
 
+TEST(DequeAllocatorTest, PmrDequeStaysOnItsResource) {
+    std::byte buffer[2048];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof buffer, std::pmr::null_memory_resource());
+
+    pmr::Deque<int> deque({1, 2, 3}, &resource);
+    deque.push_front(0);
+    EXPECT_EQ(deque[0], 0);
+    EXPECT_EQ(deque[3], 3);
+    EXPECT_EQ(deque.get_allocator().resource(), &resource);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -3,58 +3,330 @@
 
 #include "../../container.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace my_container {
 
-    template<typename T>
+    // Raw buffers for trivially relocatable elements, which may move with a
+    // plain byte copy. Small ones come from malloc and grow with realloc;
+    // from mremap_from bytes on they are anonymous mappings that mremap
+    // grows by remapping pages, without copying the data.
+    namespace vector_detail {
+#ifdef __linux__
+        constexpr size_t mremap_from = size_t(4) << 20;
+#else
+        constexpr size_t mremap_from = SIZE_MAX;
+#endif
+
+        inline bool is_mapped(size_t bytes) { return bytes >= mremap_from; }
+
+#ifdef __linux__
+        inline size_t mapped_length(size_t bytes) {
+            static const auto page = (size_t) sysconf(_SC_PAGESIZE);
+            return (bytes + page - 1) / page * page;
+        }
+#endif
+
+        inline void* raw_allocate(size_t bytes) {
+            if (bytes == 0)
+                return nullptr;
+#ifdef __linux__
+            if (is_mapped(bytes)) {
+                void* p = mmap(nullptr, mapped_length(bytes), PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED)
+                    throw std::bad_alloc();
+                return p;
+            }
+#endif
+            void* p = std::malloc(bytes);
+            if (!p)
+                throw std::bad_alloc();
+            return p;
+        }
+
+        inline void raw_deallocate(void* p, size_t bytes) {
+            if (!p)
+                return;
+#ifdef __linux__
+            if (is_mapped(bytes)) {
+                munmap(p, mapped_length(bytes));
+                return;
+            }
+#endif
+            std::free(p);
+        }
+
+        // Leaves p untouched when it throws.
+        inline void* raw_reallocate(void* p, size_t old_bytes, size_t new_bytes) {
+            if (!p || new_bytes == 0) {
+                void* fresh = raw_allocate(new_bytes);
+                raw_deallocate(p, old_bytes);
+                return fresh;
+            }
+            if (is_mapped(old_bytes) != is_mapped(new_bytes)) {
+                void* fresh = raw_allocate(new_bytes);
+                std::memcpy(fresh, p, std::min(old_bytes, new_bytes));
+                raw_deallocate(p, old_bytes);
+                return fresh;
+            }
+#ifdef __linux__
+            if (is_mapped(new_bytes)) {
+                void* moved = mremap(p, mapped_length(old_bytes), mapped_length(new_bytes), MREMAP_MAYMOVE);
+                if (moved == MAP_FAILED)
+                    throw std::bad_alloc();
+                return moved;
+            }
+#endif
+            void* moved = std::realloc(p, new_bytes);
+            if (!moved)
+                throw std::bad_alloc();
+            return moved;
+        }
+    }
+
+    // Storage past _size is raw: only the live elements are ever constructed.
+    // Memory and construction go through Allocator, so with
+    // std::pmr::polymorphic_allocator the elements get the resource too.
+    template<typename T, typename Allocator = std::allocator<T>>
     class Vector : public Container<T> {
     private:
+        using Traits = std::allocator_traits<Allocator>;
+
         T* _data = nullptr;
         size_t _size = 0;
         size_t _capacity = 0;
+        [[no_unique_address]] Allocator _alloc;
+
+        static constexpr bool default_allocator = std::is_same_v<Allocator, std::allocator<T>>;
+
+        // realloc and mremap only stand in for std::allocator: any other
+        // allocator owns its memory.
+        static constexpr bool trivially_relocatable = default_allocator && std::is_trivially_copyable_v<T> &&
+                                                      alignof(T) <= alignof(std::max_align_t);
+
+        T* allocate(size_t n) {
+            if constexpr (trivially_relocatable)
+                return static_cast<T*>(vector_detail::raw_allocate(n * sizeof(T)));
+            else
+                return n == 0 ? nullptr : Traits::allocate(_alloc, n);
+        }
+
+        void deallocate(T* data, size_t n) {
+            if constexpr (trivially_relocatable)
+                vector_detail::raw_deallocate(data, n * sizeof(T));
+            else if (data)
+                Traits::deallocate(_alloc, data, n);
+        }
+
+        template<typename... Args>
+        void construct(T* p, Args&&... args) {
+            Traits::construct(_alloc, p, std::forward<Args>(args)...);
+        }
+
+        void destroy(T* first, T* last) {
+            if constexpr (default_allocator) {
+                std::destroy(first, last);
+            } else {
+                for (; first != last; ++first)
+                    Traits::destroy(_alloc, first);
+            }
+        }
+
+        // Constructs copies of [first, last) at dest, destroying them again
+        // if one throws.
+        template<typename It>
+        void construct_range(It first, It last, T* dest) {
+            if constexpr (default_allocator) {
+                std::uninitialized_copy(first, last, dest);
+            } else {
+                T* current = dest;
+                try {
+                    for (; first != last; ++first, ++current)
+                        construct(current, *first);
+                } catch (...) {
+                    destroy(dest, current);
+                    throw;
+                }
+            }
+        }
+
+        // Constructs T(args...) in every slot of [first, last).
+        template<typename... Args>
+        void construct_each(T* first, T* last, const Args&... args) {
+            T* current = first;
+            try {
+                for (; current != last; ++current)
+                    construct(current, args...);
+            } catch (...) {
+                destroy(first, current);
+                throw;
+            }
+        }
+
+        // Moves [first, last) into raw storage at dest, or copies when a
+        // throwing move could lose elements, as std::move_if_noexcept does.
+        void relocate(T* first, T* last, T* dest) {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                construct_range(std::make_move_iterator(first), std::make_move_iterator(last), dest);
+            else
+                construct_range(first, last, dest);
+        }
+
+        template<typename It>
+        void assign_storage(It first, It last, size_t capacity) {
+            _data = allocate(capacity);
+            _capacity = capacity;
+            try {
+                construct_range(first, last, _data);
+            } catch (...) {
+                deallocate(_data, _capacity);
+                _data = nullptr;
+                _capacity = 0;
+                throw;
+            }
+            _size = (size_t) std::distance(first, last);
+        }
+
+        size_t grown_capacity() const { return _capacity == 0 ? 1 : _capacity * 2; }
+
+        void release() {
+            destroy(_data, _data + _size);
+            deallocate(_data, _capacity);
+        }
 
         void reallocate(size_t new_capacity) {
-            T* new_data = new T[new_capacity];
-            std::move(_data, _data + _size, new_data);
-            delete[] _data;
+            if constexpr (trivially_relocatable) {
+                _data = static_cast<T*>(vector_detail::raw_reallocate(_data, _capacity * sizeof(T),
+                                                                      new_capacity * sizeof(T)));
+                _capacity = new_capacity;
+                return;
+            }
+            T* new_data = allocate(new_capacity);
+            try {
+                relocate(_data, _data + _size, new_data);
+            } catch (...) {
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+            release();
             _data = new_data;
             _capacity = new_capacity;
         }
+
+        // Builds the new element in fresh storage before the old ones move
+        // out, so that args may refer to elements of this vector.
+        template<typename... Args>
+        T& emplace_reallocate(size_t pos, Args&&... args) {
+            if constexpr (trivially_relocatable) {
+                T value(std::forward<Args>(args)...);
+                reallocate(grown_capacity());
+                std::memmove(static_cast<void*>(_data + pos + 1), _data + pos, (_size - pos) * sizeof(T));
+                ++_size;
+                construct(_data + pos, value);
+                return _data[pos];
+            }
+            size_t new_capacity = grown_capacity();
+            T* new_data = allocate(new_capacity);
+            T* element = new_data + pos;
+            try {
+                construct(element, std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+            try {
+                relocate(_data, _data + pos, new_data);
+                try {
+                    relocate(_data + pos, _data + _size, element + 1);
+                } catch (...) {
+                    destroy(new_data, element);
+                    throw;
+                }
+            } catch (...) {
+                destroy(element, element + 1);
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+            release();
+            _data = new_data;
+            _capacity = new_capacity;
+            ++_size;
+            return *element;
+        }
+
     public:
+        using allocator_type = Allocator;
+
         Vector() = default;
 
-        Vector(std::initializer_list<T> init) : _size(init.size()), _capacity(init.size() * 2) {
-            _data = new T[_capacity];
-            std::copy(init.begin(), init.end(), _data);
+        explicit Vector(const Allocator& allocator) : _alloc(allocator) {}
+
+        Vector(std::initializer_list<T> init, const Allocator& allocator = Allocator()) : _alloc(allocator) {
+            assign_storage(init.begin(), init.end(), init.size() * 2);
         }
 
-        Vector(const Vector& other) : _size(other._size), _capacity(other._size) {
-            _data = new T[_capacity];
-            std::copy(other._data, other._data + _size, _data);
+        Vector(const Vector& other)
+                : Vector(other, Traits::select_on_container_copy_construction(other._alloc)) {}
+
+        Vector(const Vector& other, const Allocator& allocator) : _alloc(allocator) {
+            assign_storage(other._data, other._data + other._size, other._size);
         }
 
         Vector(Vector&& other) noexcept
-                : _data(other._data), _size(other._size), _capacity(other._capacity) {
+                : _data(other._data), _size(other._size), _capacity(other._capacity), _alloc(std::move(other._alloc)) {
             other._data = nullptr;
             other._size = 0;
             other._capacity = 0;
         }
 
-        ~Vector() override { delete[] _data; }
+        ~Vector() override { release(); }
+
+        allocator_type get_allocator() const { return _alloc; }
 
         Vector& operator=(const Vector& other) {
             if (this != &other) {
-                delete[] _data;
-                _size = other._size;
-                _capacity = other._size;
-                _data = new T[_capacity];
-                std::copy(other._data, other._data + _size, _data);
+                if constexpr (Traits::propagate_on_container_copy_assignment::value) {
+                    if (_alloc != other._alloc)
+                        clear();
+                    _alloc = other._alloc;
+                }
+                Vector copy(other, _alloc);
+                swap(copy);
             }
             return *this;
         }
 
-        Vector& operator=(Vector&& other) noexcept {
+        // A buffer from an unequal allocator that does not propagate cannot
+        // be taken over, so the elements move into a buffer of this one.
+        Vector& operator=(Vector&& other) noexcept(Traits::propagate_on_container_move_assignment::value ||
+                                                   Traits::is_always_equal::value) {
             if (this != &other) {
-                delete[] _data;
+                if (!Traits::propagate_on_container_move_assignment::value && _alloc != other._alloc) {
+                    Vector moved(_alloc);
+                    moved.assign_storage(std::make_move_iterator(other._data),
+                                         std::make_move_iterator(other._data + other._size), other._size);
+                    swap(moved);
+                    other.clear();
+                    return *this;
+                }
+                release();
+                if constexpr (Traits::propagate_on_container_move_assignment::value)
+                    _alloc = std::move(other._alloc);
                 _data = other._data;
                 _size = other._size;
                 _capacity = other._capacity;
@@ -122,52 +394,85 @@ namespace my_container {
         }
 
         void clear() {
-            delete[] _data;
+            release();
             _data = nullptr;
             _size = 0;
             _capacity = 0;
         }
 
-        void push_back(const T& value) {
-            if (_size >= _capacity) {
-                reserve(_capacity == 0 ? 1 : _capacity * 2);
-            }
-            _data[_size++] = value;
+        template<typename... Args>
+        T& emplace_back(Args&&... args) {
+            if (_size == _capacity)
+                return emplace_reallocate(_size, std::forward<Args>(args)...);
+            construct(_data + _size, std::forward<Args>(args)...);
+            return _data[_size++];
         }
 
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
         void pop_back() {
             --_size;
+            destroy(_data + _size, _data + _size + 1);
         }
 
-        void insert(size_t pos, const T& value) {
+        template<typename... Args>
+        T& emplace(size_t pos, Args&&... args) {
             if (pos > _size)
                 throw std::out_of_range("Vector");
+            if (_size == _capacity)
+                return emplace_reallocate(pos, std::forward<Args>(args)...);
+            if (pos == _size)
+                return emplace_back(std::forward<Args>(args)...);
 
-            if (_size + 1 > _capacity)
-                reserve(_capacity * 2);
-            std::move_backward(_data + pos, _data + _size, _data + _size + 1);
-            _data[pos] = value;
+            T value(std::forward<Args>(args)...);
+            construct(_data + _size, std::move(_data[_size - 1]));
             ++_size;
+            std::move_backward(_data + pos, _data + _size - 2, _data + _size - 1);
+            _data[pos] = std::move(value);
+            return _data[pos];
         }
 
+        void insert(size_t pos, const T& value) { emplace(pos, value); }
+        void insert(size_t pos, T&& value) { emplace(pos, std::move(value)); }
+
         void erase(size_t pos) {
             if (pos >= _size)
                 throw std::out_of_range("Vector");
 
             std::move(_data + pos + 1, _data + _size, _data + pos);
-            --_size;
+            pop_back();
         }
 
-        void resize(size_t count, const T& value = T()) {
-            if (count > _capacity)
+        void resize(size_t count) {
+            if (count < _size) {
+                destroy(_data + count, _data + _size);
+            } else if (count > _size) {
                 reserve(count);
-            if (count > _size)
-                std::fill(_data + _size, _data + count, value);
+                construct_each(_data + _size, _data + count);
+            }
+            _size = count;
+        }
 
+        void resize(size_t count, const T& value) {
+            if (count < _size) {
+                destroy(_data + count, _data + _size);
+            } else if (count > _size) {
+                if (count > _capacity) {
+                    // value may be an element that the reallocation moves.
+                    T copy(value);
+                    reserve(count);
+                    construct_each(_data + _size, _data + count, copy);
+                } else {
+                    construct_each(_data + _size, _data + count, value);
+                }
+            }
             _size = count;
         }
 
         void swap(Vector& other) noexcept {
+            if constexpr (Traits::propagate_on_container_swap::value)
+                std::swap(_alloc, other._alloc);
             std::swap(_data, other._data);
             std::swap(_size, other._size);
             std::swap(_capacity, other._capacity);
@@ -196,6 +501,11 @@ namespace my_container {
             return std::lexicographical_compare_three_way(_data, _data + _size, other._data, other._data + other._size);
         }
     };
+
+    namespace pmr {
+        template<typename T>
+        using Vector = my_container::Vector<T, std::pmr::polymorphic_allocator<T>>;
+    }
 }
 
 #endif //FUNDAMENTAL_ALGORITHMS_2_VECTOR_H
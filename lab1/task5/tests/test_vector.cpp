@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "../include/vector.h"
 
+#include <string>
+#include <memory_resource>
+
 using namespace my_container;
 
 class VectorTest : public ::testing::Test {
@@ -123,6 +126,148 @@ TEST_F(VectorTest, Comparisons) {
     EXPECT_TRUE(sampleVec < greater);
 }
 
+// Неинициализированная память
+namespace {
+    struct Tracked {
+        static inline int constructed = 0;
+        static inline int copied = 0;
+        static inline int alive = 0;
+
+        int value;
+
+        explicit Tracked(int v) : value(v) { constructed++, alive++; }
+        Tracked(const Tracked& other) : value(other.value) { copied++, alive++; }
+        Tracked(Tracked&& other) noexcept : value(other.value) { alive++; }
+        Tracked& operator=(const Tracked&) = default;
+        Tracked& operator=(Tracked&&) noexcept = default;
+        ~Tracked() { alive--; }
+        bool operator==(const Tracked&) const = default;
+
+        static void reset() { constructed = copied = alive = 0; }
+    };
+
+    struct ThrowingMove {
+        static inline int copied = 0;
+
+        std::string value;
+
+        explicit ThrowingMove(std::string v) : value(std::move(v)) {}
+        ThrowingMove(const ThrowingMove& other) : value(other.value) { copied++; }
+        ThrowingMove(ThrowingMove&& other) noexcept(false) : value(std::move(other.value)) {}
+        ThrowingMove& operator=(const ThrowingMove&) = default;
+        bool operator==(const ThrowingMove&) const = default;
+    };
+}
+
+TEST(VectorStorageTest, OnlyLiveElementsAreConstructed) {
+    Tracked::reset();
+    {
+        Vector<Tracked> vec;
+        vec.reserve(100);
+        EXPECT_EQ(Tracked::alive, 0);
+        for (int i = 0; i < 50; ++i)
+            vec.emplace_back(i);
+        EXPECT_EQ(Tracked::constructed, 50);
+        EXPECT_EQ(Tracked::copied, 0);
+        EXPECT_EQ(Tracked::alive, 50);
+
+        vec.pop_back();
+        vec.erase(0);
+        EXPECT_EQ(Tracked::alive, 48);
+        EXPECT_EQ(vec[0].value, 1);
+        vec.resize(10, Tracked(-1));
+        EXPECT_EQ(Tracked::alive, 10);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(VectorStorageTest, ReallocationMovesOnlyIfNoexcept) {
+    Tracked::reset();
+    Vector<Tracked> tracked;
+    for (int i = 0; i < 33; ++i)
+        tracked.emplace_back(i);
+    EXPECT_EQ(Tracked::copied, 0);
+
+    ThrowingMove::copied = 0;
+    Vector<ThrowingMove> vec;
+    for (int i = 0; i < 5; ++i)
+        vec.emplace_back(std::to_string(i));
+    EXPECT_EQ(ThrowingMove::copied, 1 + 2 + 4);
+    EXPECT_EQ(vec[4].value, "4");
+}
+
+TEST(VectorStorageTest, EmplaceAndAliasing) {
+    Vector<std::string> vec;
+    vec.emplace_back(3, 'a');
+    vec.emplace(0, "b");
+    vec.emplace(1, 2, 'c');
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[0], "b");
+    EXPECT_EQ(vec[1], "cc");
+    EXPECT_EQ(vec[2], "aaa");
+
+    // Аргумент ссылается на элемент самого вектора.
+    vec.shrink_to_fit();
+    vec.push_back(vec[0]);
+    vec.insert(0, vec[3]);
+    vec.insert(2, vec[1]);
+    EXPECT_EQ(vec.size(), 6);
+    EXPECT_EQ(vec[0], "b");
+    EXPECT_EQ(vec[2], "b");
+    EXPECT_EQ(vec[5], "b");
+
+    Vector<std::string> empty;
+    empty.insert(0, "x");
+    EXPECT_EQ(empty[0], "x");
+}
+
+TEST(VectorStorageTest, TriviallyRelocatableGrowth) {
+    // Past a few MB the buffer is a mapping that grows with mremap.
+    Vector<int> vec;
+    for (int i = 0; i < 3000000; ++i)
+        vec.push_back(i);
+    EXPECT_EQ(vec.size(), 3000000);
+    EXPECT_EQ(vec[1234567], 1234567);
+    EXPECT_EQ(vec.back(), 2999999);
+
+    vec.insert(0, vec[5]);
+    EXPECT_EQ(vec[0], 5);
+    EXPECT_EQ(vec[1], 0);
+    vec.resize(100);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 100);
+    EXPECT_EQ(vec[99], 98);
+
+    Vector<int> copy(vec);
+    copy.reserve(2000000);
+    EXPECT_EQ(copy, vec);
+    copy.clear();
+    EXPECT_EQ(copy.capacity(), 0);
+}
+
+// Аллокаторы
+TEST(VectorAllocatorTest, PmrVectorStaysOnItsResource) {
+    std::byte buffer[16384];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof buffer, std::pmr::null_memory_resource());
+
+    pmr::Vector<std::pmr::string> vec(&resource);
+    for (int i = 0; i < 20; ++i)
+        vec.emplace_back(40, char('a' + i));
+    EXPECT_EQ(vec.size(), 20);
+    EXPECT_EQ(vec[19], std::pmr::string(40, 't'));
+    EXPECT_EQ(vec.get_allocator().resource(), &resource);
+    EXPECT_EQ(vec[0].get_allocator().resource(), &resource);
+
+    pmr::Vector<std::pmr::string> copy(vec, &resource);
+    EXPECT_EQ(copy, vec);
+
+    pmr::Vector<std::pmr::string> other;
+    other = std::move(vec);
+    EXPECT_EQ(other.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(other[0].get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(other, copy);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
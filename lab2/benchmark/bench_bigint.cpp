@@ -0,0 +1,316 @@
+#include "basic_bigint.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr unsigned long long BASE = 1000000;
+    const int BLOCK_SIZE = (int) std::log10((double) BASE);
+
+    template<typename T>
+    void do_not_optimize(T& value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    std::string random_digits(size_t limbs, std::mt19937_64& rng) {
+        std::uniform_int_distribution<int> digit('0', '9');
+        std::string str(limbs * BLOCK_SIZE, '0');
+        for (char& c : str)
+            c = (char) digit(rng);
+        str[0] = (char) std::uniform_int_distribution<int>('1', '9')(rng);
+        return str;
+    }
+
+    template<typename Int>
+    Int random_bigint(size_t limbs, std::mt19937_64& rng) {
+        return Int(random_digits(limbs, rng));
+    }
+
+    // Runs op until at least min_seconds have passed and returns ns per call.
+    double measure(const std::function<void()>& op, double min_seconds) {
+        using clock = std::chrono::steady_clock;
+        size_t iterations = 0;
+        auto start = clock::now();
+        double elapsed = 0;
+        do {
+            op();
+            iterations++;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < min_seconds);
+        return elapsed * 1e9 / (double) iterations;
+    }
+
+    struct Operation {
+        std::string name;
+        std::function<std::function<void()>(size_t, std::mt19937_64&)> prepare;
+    };
+
+    template<typename Int>
+    std::vector<Operation> operations() {
+        std::vector<Operation> ops;
+
+        ops.push_back({"add", [](size_t n, std::mt19937_64& rng) {
+            return [a = random_bigint<Int>(n, rng), b = random_bigint<Int>(n, rng)] {
+                Int c = a + b;
+                do_not_optimize(c);
+            };
+        }});
+        ops.push_back({"sub", [](size_t n, std::mt19937_64& rng) {
+            return [a = random_bigint<Int>(n, rng), b = random_bigint<Int>(n, rng)] {
+                Int c = a - b;
+                do_not_optimize(c);
+            };
+        }});
+        ops.push_back({"mul", [](size_t n, std::mt19937_64& rng) {
+            return [a = random_bigint<Int>(n, rng), b = random_bigint<Int>(n, rng)] {
+                Int c = a * b;
+                do_not_optimize(c);
+            };
+        }});
+        ops.push_back({"div", [](size_t n, std::mt19937_64& rng) {
+            return [a = random_bigint<Int>(n, rng), b = random_bigint<Int>((n + 1) / 2, rng)] {
+                Int c = a / b;
+                do_not_optimize(c);
+            };
+        }});
+        ops.push_back({"mod", [](size_t n, std::mt19937_64& rng) {
+            return [a = random_bigint<Int>(n, rng), b = random_bigint<Int>((n + 1) / 2, rng)] {
+                Int c = a % b;
+                do_not_optimize(c);
+            };
+        }});
+        ops.push_back({"mod_exp", [](size_t n, std::mt19937_64& rng) {
+            return [a = random_bigint<Int>(n, rng), e = random_bigint<Int>(1, rng), m = random_bigint<Int>(n, rng)] {
+                Int c = mod_exp(a, e, m);
+                do_not_optimize(c);
+            };
+        }});
+        ops.push_back({"parse", [](size_t n, std::mt19937_64& rng) {
+            return [str = random_digits(n, rng)] {
+                std::istringstream is(str);
+                Int c;
+                is >> c;
+                do_not_optimize(c);
+            };
+        }});
+        ops.push_back({"print", [](size_t n, std::mt19937_64& rng) {
+            return [a = random_bigint<Int>(n, rng)] {
+                std::ostringstream os;
+                os << a;
+                std::string str = os.str();
+                do_not_optimize(str);
+            };
+        }});
+        return ops;
+    }
+
+    // One BasicBigInt instantiation: a multiplication and a division policy.
+    struct Stack {
+        std::string name;
+        std::string policies;
+        std::vector<Operation> ops;
+    };
+
+    template<typename MulPolicy, typename DivPolicy>
+    Stack stack(std::string name, std::string policies) {
+        return {std::move(name), std::move(policies),
+                operations<BasicBigInt<unsigned long long, MulPolicy, DivPolicy, BASE>>()};
+    }
+
+    std::vector<Stack> stacks() {
+        std::vector<Stack> list;
+        list.push_back(stack<SchoolbookMultiply, LongDivision>(
+                "school/long", "SchoolbookMultiply, LongDivision (task1-task3)"));
+        list.push_back(stack<KaratsubaMultiply, LongDivision>(
+                "karat/long", "KaratsubaMultiply, LongDivision (task4)"));
+        list.push_back(stack<KaratsubaMultiply, SchoolbookDivision>(
+                "karat/school", "KaratsubaMultiply, SchoolbookDivision"));
+        list.push_back(stack<KaratsubaMultiply, NewtonDivision<>>(
+                "karat/newton", "KaratsubaMultiply, NewtonDivision<KaratsubaMultiply>"));
+        list.push_back(stack<ParallelMultiply<>, NewtonDivision<ParallelMultiply<>>>(
+                "parallel", "ParallelMultiply<>, NewtonDivision<ParallelMultiply<>>"));
+        list.push_back(stack<DispatchMultiply<>, DispatchDivision<>>(
+                "dispatch", "DispatchMultiply<>, DispatchDivision<>"));
+        return list;
+    }
+
+    // Every operation on every stack at ten times more limbs per row. A stack
+    // drops out of an operation once its next size would blow the budget.
+    void run_operations(const std::vector<Stack>& list, size_t max_limbs, double budget, double min_seconds) {
+        std::mt19937_64 rng(42);
+        std::printf("%-8s %10s", "ns/op", "limbs");
+        for (const Stack& s : list)
+            std::printf(" %14s", s.name.c_str());
+        std::printf("\n");
+
+        for (size_t op = 0; op < list[0].ops.size(); ++op) {
+            std::vector<bool> active(list.size(), true);
+            for (size_t n = 1; n <= max_limbs; n *= 10) {
+                if (std::find(active.begin(), active.end(), true) == active.end())
+                    break;
+                std::printf("%-8s %10zu", list[0].ops[op].name.c_str(), n);
+                for (size_t s = 0; s < list.size(); ++s) {
+                    if (!active[s]) {
+                        std::printf(" %14s", "-");
+                        continue;
+                    }
+                    double ns = measure(list[s].ops[op].prepare(n, rng), min_seconds);
+                    std::printf(" %14.0f", ns);
+                    // The next size is ten times larger; stop before a
+                    // quadratic operation would blow through the budget.
+                    if (ns * 100 > budget * 1e9)
+                        active[s] = false;
+                }
+                std::printf("\n");
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    using Limbs = BasicBigInt<unsigned long long, SchoolbookMultiply, SchoolbookDivision, BASE>::limbs_type;
+
+    Limbs random_limbs(size_t n, std::mt19937_64& rng) {
+        std::uniform_int_distribution<unsigned long long> limb(0, BASE - 1);
+        Limbs limbs(n);
+        for (auto& x : limbs)
+            x = limb(rng);
+        limbs.back() = std::max<unsigned long long>(limbs.back(), 1);
+        return limbs;
+    }
+
+    // A single policy, built into its own BasicBigInt. prepare converts the
+    // operands once and returns the timed call, which leaves the limbs of
+    // its result in out.
+    struct Tier {
+        std::string name;
+        std::function<std::function<void()>(const Limbs&, const Limbs&, Limbs&)> prepare;
+    };
+
+    template<typename MulPolicy>
+    Tier multiply_tier(std::string name) {
+        using Int = BasicBigInt<unsigned long long, MulPolicy, SchoolbookDivision, BASE>;
+        return {std::move(name), [](const Limbs& a, const Limbs& b, Limbs& out) -> std::function<void()> {
+            return [x = Int::from_limbs(a), y = Int::from_limbs(b), &out] { out = (x * y).limbs(); };
+        }};
+    }
+
+    template<typename DivPolicy>
+    Tier divide_tier(std::string name) {
+        using Int = BasicBigInt<unsigned long long, DispatchMultiply<>, DivPolicy, BASE>;
+        return {std::move(name), [](const Limbs& a, const Limbs& b, Limbs& out) -> std::function<void()> {
+            return [x = Int::from_limbs(a), y = Int::from_limbs(b), &out] { out = (x / y).limbs(); };
+        }};
+    }
+
+    std::vector<Tier> multiply_tiers() {
+        return {multiply_tier<SchoolbookMultiply>("schoolbook"),
+                multiply_tier<KaratsubaMultiply>("karatsuba"),
+                multiply_tier<FftMultiply>("fft"),
+                multiply_tier<DispatchMultiply<>::ssa_policy<BASE>>("ssa"),
+                multiply_tier<ParallelMultiply<>>("parallel"),
+                multiply_tier<DispatchMultiply<>>("dispatch")};
+    }
+
+    std::vector<Tier> divide_tiers() {
+        return {divide_tier<SchoolbookDivision>("schoolbook"),
+                divide_tier<LongDivision>("long"),
+                divide_tier<NewtonDivision<>>("newton"),
+                divide_tier<NewtonDivision<DispatchMultiply<>>>("newton-disp"),
+                divide_tier<DispatchDivision<>>("dispatch")};
+    }
+
+    // Times every tier on the same operands, a of dividend_factor * n limbs
+    // and b of n, and reports where each one overtakes the first.
+    void run_crossover(const char* title, const std::vector<Tier>& tiers, size_t dividend_factor,
+                       size_t max_limbs, double budget, double min_seconds) {
+        std::mt19937_64 rng(7);
+        std::vector<bool> active(tiers.size(), true);
+        std::vector<size_t> crossover(tiers.size(), 0);
+
+        std::printf("\n%-8s %10s", title, "limbs");
+        for (const Tier& tier : tiers)
+            std::printf(" %14s", tier.name.c_str());
+        std::printf(" %14s\n", "fastest");
+
+        // The first tier is the reference for both correctness and crossover,
+        // so the table ends once it runs out of budget.
+        for (size_t n = 1; n <= max_limbs && active[0]; n *= 2) {
+            Limbs a = random_limbs(n * dividend_factor, rng), b = random_limbs(n, rng);
+            Limbs expected, result;
+            tiers[0].prepare(a, b, expected)();
+            std::vector<double> times(tiers.size(), -1);
+
+            std::printf("%-8s %10zu", "", n);
+            for (size_t t = 0; t < tiers.size(); ++t) {
+                if (!active[t]) {
+                    std::printf(" %14s", "-");
+                    continue;
+                }
+                std::function<void()> run = tiers[t].prepare(a, b, result);
+                run();
+                if (result != expected) {
+                    active[t] = false;
+                    std::printf(" %14s", "wrong");
+                    continue;
+                }
+                times[t] = measure(run, min_seconds);
+                std::printf(" %14.0f", times[t]);
+                if (times[t] * 4 > budget * 1e9)
+                    active[t] = false;
+            }
+
+            size_t fastest = 0;
+            for (size_t t = 1; t < tiers.size(); ++t)
+                if (times[t] >= 0 && (times[fastest] < 0 || times[t] < times[fastest]))
+                    fastest = t;
+            std::printf(" %14s\n", tiers[fastest].name.c_str());
+            std::fflush(stdout);
+
+            for (size_t t = 1; t < tiers.size(); ++t) {
+                if (times[t] < 0 || times[0] < 0)
+                    continue;
+                if (times[t] < times[0]) {
+                    if (crossover[t] == 0)
+                        crossover[t] = n;
+                } else {
+                    crossover[t] = 0;
+                }
+            }
+        }
+
+        std::printf("\n%s crossover against %s:\n", title, tiers[0].name.c_str());
+        for (size_t t = 1; t < tiers.size(); ++t) {
+            if (crossover[t] != 0)
+                std::printf("  %-12s faster from %zu limbs\n", tiers[t].name.c_str(), crossover[t]);
+            else
+                std::printf("  %-12s no crossover in measured range\n", tiers[t].name.c_str());
+        }
+    }
+}
+
+// Compares the BasicBigInt policy mixes side by side: every operation on
+// every stack, then each multiplication and division policy on its own.
+// Usage: bench_bigint [max_limbs] [budget_seconds] [min_seconds_per_point]
+int main(int argc, char** argv) {
+    size_t max_limbs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    double budget = argc > 2 ? std::strtod(argv[2], nullptr) : 2.0;
+    double min_seconds = argc > 3 ? std::strtod(argv[3], nullptr) : 0.05;
+
+    std::vector<Stack> list = stacks();
+    std::printf("base %llu\n", BASE);
+    for (const Stack& s : list)
+        std::printf("  %-14s %s\n", s.name.c_str(), s.policies.c_str());
+    std::printf("\n");
+
+    run_operations(list, max_limbs, budget, min_seconds);
+    run_crossover("multiply", multiply_tiers(), 1, max_limbs, budget, min_seconds);
+    run_crossover("divide", divide_tiers(), 2, max_limbs, budget, min_seconds);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "constants.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// The stack the library ships: whatever thresholds the tuner wrote pick the
+// Karatsuba, FFT and Schönhage–Strassen tiers, so a bad crossover or a broken
+// kernel shows up as wrong digits.
+using Int = BasicBigInt<unsigned long long, DispatchMultiply<>, DispatchDivision<>>;
+
+namespace {
+    const std::string PI_PREFIX = "3.14159265358979323846264338327950288419716939937510";
+    const std::string E_PREFIX = "2.71828182845904523536028747135266249775724709369995";
+
+    struct Constant {
+        const char* name;
+        std::string (*compute)(size_t, DigitTimings*);
+        const std::string& prefix;
+        std::string previous;
+        bool done = false;
+    };
+
+    double total(const DigitTimings& t) {
+        return t.splitting + t.sqrt + t.division + t.conversion;
+    }
+}
+
+// Computes pi and e for ten times more digits per row and prints the time of
+// every phase. Exits with 1 if the digits disagree with the known prefix or
+// with the previous, shorter run, so it doubles as a regression gate.
+int main(int argc, char** argv) {
+    size_t min_digits = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    size_t max_digits = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+    double budget = argc > 3 ? std::strtod(argv[3], nullptr) : 60.0;
+
+    Constant constants[] = {{"pi", pi_digits<Int>, PI_PREFIX, {}}, {"e", e_digits<Int>, E_PREFIX, {}}};
+
+    std::printf("%-4s %10s %10s %10s %10s %10s %10s\n", "", "digits", "splitting", "sqrt", "division",
+                "conversion", "total");
+    for (size_t digits = min_digits; digits <= max_digits; digits *= 10) {
+        for (Constant& constant : constants) {
+            if (constant.done)
+                continue;
+
+            DigitTimings t;
+            std::string result = constant.compute(digits, &t);
+            std::printf("%-4s %10zu %10.3f %10.3f %10.3f %10.3f %10.3f\n", constant.name, digits, t.splitting,
+                        t.sqrt, t.division, t.conversion, total(t));
+
+            const std::string& expected = constant.previous.empty() ? constant.prefix : constant.previous;
+            size_t checked = std::min(expected.size(), result.size());
+            if (result.compare(0, checked, expected, 0, checked) != 0) {
+                std::printf("%s: digits disagree with the %s\n", constant.name,
+                            constant.previous.empty() ? "known prefix" : "previous run");
+                return 1;
+            }
+            constant.previous = std::move(result);
+
+            // Ten times the digits costs well over ten times the time.
+            constant.done = total(t) * 30 > budget;
+        }
+        std::fflush(stdout);
+    }
+    return 0;
+}
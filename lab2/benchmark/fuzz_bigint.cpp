@@ -0,0 +1,272 @@
+// The harness checks the built-in tiers, whatever an earlier tuning run wrote.
+#define BIGINT_DEFAULT_THRESHOLDS
+#include "basic_bigint.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    using Limbs = std::vector<unsigned long long>;
+    constexpr unsigned long long BASE = 1000000;
+
+    std::mt19937_64 rng;
+
+    // Operand shapes. Besides uniform limbs, each one stresses a path that
+    // random operands rarely reach: a carry through every limb, a single
+    // non-zero limb, long zero runs and an almost-power of the base.
+    struct Shape {
+        const char* name;
+        std::function<Limbs(size_t)> make;
+    };
+
+    const std::vector<Shape> shapes = {
+            {"random", [](size_t n) {
+                std::uniform_int_distribution<unsigned long long> limb(0, BASE - 1);
+                Limbs limbs(n);
+                for (auto& x : limbs)
+                    x = limb(rng);
+                limbs.back() = std::max<unsigned long long>(limbs.back(), 1);
+                return limbs;
+            }},
+            {"all-max", [](size_t n) { return Limbs(n, BASE - 1); }},
+            {"power", [](size_t n) {
+                Limbs limbs(n, 0);
+                limbs.back() = 1;
+                return limbs;
+            }},
+            {"carry-chain", [](size_t n) {
+                Limbs limbs(n, BASE - 1);
+                limbs.back() = 1;
+                return limbs;
+            }},
+            {"sparse", [](size_t n) {
+                Limbs limbs(n, 0);
+                std::uniform_int_distribution<size_t> position(0, n - 1);
+                for (size_t k = 0; k < 3; ++k)
+                    limbs[position(rng)] = BASE - 1 - k;
+                limbs.back() = BASE / 2;
+                return limbs;
+            }},
+    };
+
+    // Seconds per call, averaged over enough calls to fill min_time.
+    double seconds_per_call(const std::function<void()>& f, double min_time) {
+        using clock = std::chrono::steady_clock;
+        size_t calls = 0;
+        auto start = clock::now();
+        double elapsed = 0;
+        do {
+            f();
+            calls++;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < min_time);
+        return elapsed / (double) calls;
+    }
+
+    using MultiplyKernel = std::function<void(const Limbs&, const Limbs&, Limbs&)>;
+    using DivideKernel = std::function<void(const Limbs&, const Limbs&, Limbs&, Limbs&)>;
+
+    // Every policy runs on operands up to max_limbs only, so that the
+    // quadratic ones do not dominate the run.
+    struct Multiplier {
+        const char* name;
+        MultiplyKernel run;
+        size_t max_limbs;
+    };
+
+    struct Divider {
+        const char* name;
+        DivideKernel run;
+        size_t max_limbs;
+    };
+
+    template<typename Policy>
+    MultiplyKernel multiplication() {
+        return [](const Limbs& a, const Limbs& b, Limbs& result) {
+            Policy::template multiply<BASE>(a, b, result);
+        };
+    }
+
+    template<typename Policy>
+    DivideKernel division() {
+        return [](const Limbs& a, const Limbs& b, Limbs& quotient, Limbs& remainder) {
+            Policy::template divide<BASE>(a, b, quotient, remainder);
+        };
+    }
+
+    // The reference is the first entry of each list. Small thresholds on the
+    // recursive and dispatching policies make every tier boundary show up at
+    // sizes the harness can afford.
+    const std::vector<Multiplier> multipliers = {
+            {"schoolbook", multiplication<SchoolbookMultiply>(), SIZE_MAX},
+            {"karatsuba", multiplication<KaratsubaMultiply>(), SIZE_MAX},
+            {"karatsuba-4", multiplication<BasicKaratsubaMultiply<4>>(), SIZE_MAX},
+            {"fft", multiplication<FftMultiply>(), SIZE_MAX},
+            {"fft-unpacked", multiplication<BasicFftMultiply<false>>(), SIZE_MAX},
+            {"ssa", multiplication<SchonhageStrassenMultiply<KaratsubaMultiply, 64>>(), SIZE_MAX},
+            {"ssa-fft", multiplication<SchonhageStrassenMultiply<FftMultiply, 256>>(), SIZE_MAX},
+            {"parallel", multiplication<ParallelMultiply<KaratsubaMultiply, 256>>(), SIZE_MAX},
+            {"dispatch", multiplication<DispatchMultiply<>>(), SIZE_MAX},
+            {"dispatch-small", multiplication<DispatchMultiply<8, 64, 512>>(), SIZE_MAX},
+    };
+
+    const std::vector<Divider> dividers = {
+            {"schoolbook", division<SchoolbookDivision>(), SIZE_MAX},
+            {"long", division<LongDivision>(), 16},
+            {"newton", division<NewtonDivision<KaratsubaMultiply>>(), SIZE_MAX},
+            {"newton-dispatch", division<NewtonDivision<DispatchMultiply<>>>(), SIZE_MAX},
+            {"dispatch", division<DispatchDivision<>>(), SIZE_MAX},
+            {"dispatch-small", division<DispatchDivision<8>>(), SIZE_MAX},
+            {"dispatch-karatsuba", division<DispatchDivision<8, KaratsubaMultiply>>(), SIZE_MAX},
+    };
+
+    std::string describe(const Limbs& limbs) {
+        std::string str = std::to_string(limbs.size()) + " limbs [";
+        for (size_t i = limbs.size(); i-- > 0 && limbs.size() - i <= 4;)
+            str += std::to_string(limbs[i]) + (i > 0 ? " " : "");
+        return str + (limbs.size() > 4 ? "...]" : "]");
+    }
+
+    struct Harness {
+        double min_time;
+        std::ofstream csv;
+        size_t checks = 0, failures = 0;
+
+        void fail(const char* operation, const char* name, const std::string& case_name, const Limbs& a,
+                  const Limbs& b) {
+            failures++;
+            std::printf("MISMATCH %s %s on %s: a = %s, b = %s\n", operation, name, case_name.c_str(),
+                        describe(a).c_str(), describe(b).c_str());
+        }
+
+        void record(const char* operation, const char* name, const std::string& case_name, size_t n,
+                    double seconds) {
+            if (csv)
+                csv << operation << ',' << name << ',' << case_name << ',' << n << ',' << seconds << '\n';
+        }
+
+        void multiply(const std::string& case_name, const Limbs& a, const Limbs& b) {
+            Limbs expected;
+            multipliers[0].run(a, b, expected);
+            size_t n = std::min(a.size(), b.size());
+            std::printf("%-28s %8zu", case_name.c_str(), n);
+            for (const Multiplier& m : multipliers) {
+                if (n > m.max_limbs) {
+                    std::printf(" %12s", "-");
+                    continue;
+                }
+                Limbs result;
+                m.run(a, b, result);
+                checks++;
+                if (result != expected)
+                    fail("multiply", m.name, case_name, a, b);
+                double seconds = seconds_per_call([&] { m.run(a, b, result); }, min_time);
+                record("multiply", m.name, case_name, n, seconds);
+                std::printf(" %12.6f", seconds);
+            }
+            std::printf("\n");
+        }
+
+        void divide(const std::string& case_name, const Limbs& a, const Limbs& b) {
+            // The reference itself is checked through a = q * b + r, r < b.
+            Limbs expected_q, expected_r, product;
+            dividers[0].run(a, b, expected_q, expected_r);
+            multipliers[0].run(expected_q, b, product);
+            bigint_detail::add_shifted<BASE>(product, expected_r, 0);
+            checks++;
+            if (product != a || bigint_detail::compare(expected_r, b) != std::strong_ordering::less)
+                fail("divide", dividers[0].name, case_name, a, b);
+
+            size_t n = b.size();
+            std::printf("%-28s %8zu", case_name.c_str(), n);
+            for (const Divider& d : dividers) {
+                if (a.size() > d.max_limbs) {
+                    std::printf(" %12s", "-");
+                    continue;
+                }
+                Limbs quotient, remainder;
+                d.run(a, b, quotient, remainder);
+                checks++;
+                if (quotient != expected_q || remainder != expected_r)
+                    fail("divide", d.name, case_name, a, b);
+                double seconds = seconds_per_call([&] { d.run(a, b, quotient, remainder); }, min_time);
+                record("divide", d.name, case_name, n, seconds);
+                std::printf(" %12.6f", seconds);
+            }
+            std::printf("\n");
+        }
+    };
+
+    template<typename List>
+    void header(const char* title, const List& list) {
+        std::printf("\n%-28s %8s", title, "limbs");
+        for (const auto& entry : list)
+            std::printf(" %12s", entry.name);
+        std::printf("\n");
+    }
+}
+
+// Runs every multiplication and division policy on random and adversarial
+// operands, checks each result against schoolbook and prints seconds per
+// call. Exits with 1 on any mismatch. Arguments:
+// [max_limbs=1024] [seed=1] [timings.csv] [min_time=0.002]
+int main(int argc, char** argv) {
+    size_t max_limbs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    unsigned long long seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+    Harness harness{argc > 4 ? std::strtod(argv[4], nullptr) : 0.002, {}};
+    if (argc > 3) {
+        harness.csv.open(argv[3]);
+        if (!harness.csv) {
+            std::fprintf(stderr, "cannot write %s\n", argv[3]);
+            return 1;
+        }
+        harness.csv << "operation,policy,case,limbs,seconds\n";
+    }
+    rng.seed(seed);
+
+    // Powers of two and a random size between each pair, so that both exact
+    // transform lengths and ragged ones come up.
+    std::vector<size_t> sizes;
+    for (size_t n = 1; n <= max_limbs; n *= 2) {
+        sizes.push_back(n);
+        if (n > 1 && 2 * n <= max_limbs)
+            sizes.push_back(std::uniform_int_distribution<size_t>(n + 1, 2 * n - 1)(rng));
+    }
+
+    header("multiply", multipliers);
+    for (size_t n : sizes) {
+        for (const Shape& x : shapes) {
+            for (const Shape& y : shapes) {
+                std::string case_name = std::string(x.name) + " x " + y.name;
+                harness.multiply(case_name, x.make(n), y.make(n));
+            }
+            // Unbalanced operands take the chunked paths.
+            harness.multiply(std::string(x.name) + " x random/3", x.make(3 * n), shapes[0].make(n));
+        }
+    }
+
+    header("divide", dividers);
+    for (size_t n : sizes) {
+        for (const Shape& x : shapes) {
+            for (const Shape& y : shapes) {
+                std::string case_name = std::string(x.name) + " / " + y.name;
+                harness.divide(case_name, x.make(2 * n), y.make(n));
+            }
+            // The quotient estimate overshoots most often for a numerator
+            // just below a multiple of the divisor.
+            Limbs b = x.make(n), a;
+            multipliers[0].run(b, shapes[0].make(n), a);
+            bigint_detail::sub_shifted<BASE>(a, Limbs{1}, 0);
+            harness.divide(std::string(x.name) + " / below multiple", a, b);
+        }
+    }
+
+    std::printf("\n%zu checks, %zu mismatches (seed %llu)\n", harness.checks, harness.failures, seed);
+    return harness.failures == 0 ? 0 : 1;
+}
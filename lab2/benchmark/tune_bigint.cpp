@@ -0,0 +1,236 @@
+// The tuner measures with the built-in defaults, whatever an earlier run wrote.
+#define BIGINT_DEFAULT_THRESHOLDS
+#include "basic_bigint.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+    using Limbs = std::vector<unsigned long long>;
+    constexpr unsigned long long BASE = 1000000;
+
+    std::mt19937_64 rng(2718);
+
+    Limbs random_limbs(size_t n) {
+        std::uniform_int_distribution<unsigned long long> limb(0, BASE - 1);
+        Limbs limbs(n);
+        for (auto& x : limbs)
+            x = limb(rng);
+        limbs.back() = std::max<unsigned long long>(limbs.back(), 1);
+        return limbs;
+    }
+
+    // Seconds per call, averaged over enough calls to fill min_time.
+    double seconds_per_call(const std::function<void()>& f, double min_time) {
+        using clock = std::chrono::steady_clock;
+        size_t calls = 0;
+        auto start = clock::now();
+        double elapsed = 0;
+        do {
+            f();
+            calls++;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < min_time);
+        return elapsed / (double) calls;
+    }
+
+    using Kernel = std::function<void(const Limbs&, const Limbs&)>;
+    using MultiplyFn = void (*)(const Limbs&, const Limbs&, Limbs&);
+
+    // The faster kernel to time at n limbs. A tier whose threshold is a
+    // template argument is timed at its own threshold, where it does one
+    // level of its recursion.
+    struct Candidate {
+        size_t n;
+        Kernel fast;
+    };
+
+    // First candidate from which the faster kernel wins at two consecutive
+    // sizes, or the last one when it never does.
+    size_t crossover(const char* name, const Kernel& slow, const std::vector<Candidate>& candidates,
+                     size_t dividend_factor, double min_time) {
+        std::printf("%s\n%10s %12s %12s\n", name, "limbs", "old tier", "new tier");
+        size_t found = 0;
+        for (const Candidate& candidate : candidates) {
+            size_t n = candidate.n;
+            Limbs a = random_limbs(n * dividend_factor), b = random_limbs(n);
+            double slow_time = seconds_per_call([&] { slow(a, b); }, min_time);
+            double fast_time = seconds_per_call([&] { candidate.fast(a, b); }, min_time);
+            std::printf("%10zu %12.6f %12.6f\n", n, slow_time, fast_time);
+            std::fflush(stdout);
+
+            if (fast_time >= slow_time)
+                found = 0;
+            else if (found == 0)
+                found = n;
+            else
+                return found;
+        }
+        return candidates.back().n;
+    }
+
+    std::vector<Candidate> growing(const Kernel& fast, size_t from, size_t limit, double growth) {
+        std::vector<Candidate> candidates;
+        for (size_t n = from; n <= limit; n = std::max(n + 1, (size_t) ((double) n * growth)))
+            candidates.push_back({n, fast});
+        return candidates;
+    }
+
+    template<typename Policy>
+    void multiply_into(const Limbs& a, const Limbs& b, Limbs& result) {
+        Policy::template multiply<BASE>(a, b, result);
+    }
+
+    Kernel multiplication(MultiplyFn multiply) {
+        return [multiply](const Limbs& a, const Limbs& b) {
+            Limbs result;
+            multiply(a, b, result);
+        };
+    }
+
+    template<typename Policy>
+    Kernel multiplication() {
+        return multiplication(multiply_into<Policy>);
+    }
+
+    template<typename Policy>
+    Kernel division() {
+        return [](const Limbs& a, const Limbs& b) {
+            Limbs quotient, remainder;
+            Policy::template divide<BASE>(a, b, quotient, remainder);
+        };
+    }
+
+    // Every threshold a tier can be tuned to, with the instance that
+    // DispatchMultiply would run for it.
+    struct Instance {
+        size_t threshold;
+        MultiplyFn multiply;
+    };
+
+    template<size_t... From>
+    std::vector<Instance> karatsuba_instances(std::index_sequence<From...>) {
+        return {{From, multiply_into<typename DispatchMultiply<From>::karatsuba_policy>}...};
+    }
+
+    template<size_t... From>
+    std::vector<Instance> ssa_instances(std::index_sequence<From...>) {
+        return {{From, multiply_into<typename DispatchMultiply<BIGINT_KARATSUBA_FROM, BIGINT_FFT_FROM,
+                                                              From>::template ssa_policy<BASE>>}...};
+    }
+
+    const std::vector<Instance> karatsuba_table = karatsuba_instances(
+            std::index_sequence<8, 10, 12, 14, 16, 20, 24, 28, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224,
+                                256, 320, 384, 448, 512>());
+    const std::vector<Instance> ssa_table = ssa_instances(
+            std::index_sequence<16384, 32768, 65536, 131072, 262144, 524288, 1048576, 2097152, 4194304>());
+
+    MultiplyFn instance_for(const std::vector<Instance>& table, size_t threshold) {
+        for (const Instance& instance : table) {
+            if (instance.threshold == threshold)
+                return instance.multiply;
+        }
+        return nullptr;
+    }
+
+    // DispatchMultiply with the crossovers measured in this run, so that the
+    // division timings never depend on an earlier run's header.
+    struct Measured {
+        static inline size_t karatsuba_from, fft_from, ssa_from;
+        static inline MultiplyFn karatsuba, ssa;
+    };
+
+    struct MeasuredKaratsuba {
+        template<auto Base, typename L>
+        static void multiply(const L& a, const L& b, L& result) {
+            static_assert(Base == BASE);
+            Measured::karatsuba(a, b, result);
+        }
+    };
+
+    struct MeasuredSsa {
+        template<auto Base, typename L>
+        static void multiply(const L& a, const L& b, L& result) {
+            static_assert(Base == BASE);
+            Measured::ssa(a, b, result);
+        }
+    };
+
+    struct MeasuredMultiply {
+        template<auto Base, typename L>
+        static void multiply(const L& a, const L& b, L& result) {
+            bigint_detail::dispatch_multiply<Base, MeasuredKaratsuba, MeasuredSsa>(
+                    a, b, result, Measured::karatsuba_from, Measured::fft_from, Measured::ssa_from);
+        }
+    };
+}
+
+// Times neighbouring tiers at growing sizes and writes the crossovers as a
+// header that bigint_thresholds.h includes. Arguments:
+// [output=bigint_thresholds.generated.h] [max_ssa_limbs=262144] [min_time=0.05]
+int main(int argc, char** argv) {
+    const char* output = argc > 1 ? argv[1] : "bigint_thresholds.generated.h";
+    size_t max_ssa = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : BIGINT_SSA_FROM;
+    double min_time = argc > 3 ? std::strtod(argv[3], nullptr) : 0.05;
+
+    std::vector<Candidate> karatsuba_candidates;
+    for (const Instance& instance : karatsuba_table)
+        karatsuba_candidates.push_back({instance.threshold, multiplication(instance.multiply)});
+    size_t karatsuba_from = crossover("schoolbook -> karatsuba", multiplication<SchoolbookMultiply>(),
+                                      karatsuba_candidates, 1, min_time);
+    MultiplyFn karatsuba = instance_for(karatsuba_table, karatsuba_from);
+
+    size_t fft_from = crossover("karatsuba -> fft", multiplication(karatsuba),
+                                growing(multiplication<FftMultiply>(), 64, 16384, 1.25), 1, min_time);
+
+    // Past max_ssa the FFT is not trusted to be exact, so the crossover never
+    // goes above it.
+    std::vector<Candidate> ssa_candidates;
+    for (const Instance& instance : ssa_table) {
+        if (instance.threshold <= max_ssa)
+            ssa_candidates.push_back({instance.threshold, multiplication(instance.multiply)});
+    }
+    if (ssa_candidates.empty()) {
+        std::fprintf(stderr, "max_ssa_limbs must be at least %zu\n", ssa_table.front().threshold);
+        return 1;
+    }
+    size_t ssa_from = crossover("fft -> schonhage-strassen", multiplication<FftMultiply>(), ssa_candidates, 1,
+                                min_time);
+
+    Measured::karatsuba_from = karatsuba_from;
+    Measured::fft_from = fft_from;
+    Measured::ssa_from = ssa_from;
+    Measured::karatsuba = karatsuba;
+    Measured::ssa = instance_for(ssa_table, ssa_from);
+    // The Newton tier DispatchDivision runs, over the multiplication tiers
+    // measured above. Up to its own threshold NewtonDivision still divides
+    // by schoolbook, so the sweep starts past it.
+    using Newton = DispatchDivision<BIGINT_NEWTON_FROM, MeasuredMultiply>::newton_policy;
+    size_t newton_from = crossover("schoolbook -> newton division", division<SchoolbookDivision>(),
+                                   growing(division<Newton>(), Newton::threshold + 1, 4096, 1.25), 2, min_time);
+
+    std::ofstream out(output);
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", output);
+        return 1;
+    }
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof date, "%Y-%m-%d", std::localtime(&now));
+    out << "// Generated by tune_bigint on " << date << ". Rerun tune_bigint_thresholds to refresh.\n"
+        << "#define BIGINT_KARATSUBA_FROM " << karatsuba_from << "\n"
+        << "#define BIGINT_FFT_FROM " << fft_from << "\n"
+        << "#define BIGINT_SSA_FROM " << ssa_from << "\n"
+        << "#define BIGINT_NEWTON_FROM " << newton_from << "\n";
+
+    std::printf("karatsuba_from %zu, fft_from %zu, ssa_from %zu, newton_from %zu -> %s\n", karatsuba_from,
+                fft_from, ssa_from, newton_from, output);
+    return 0;
+}
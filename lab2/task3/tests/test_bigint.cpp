@@ -66,6 +66,89 @@ TEST_F(BigIntTest, Multiplication_MixedSigns) {
     EXPECT_EQ(minusOne * large1, -large1);
 }
 
+TEST_F(BigIntTest, Literal_Big) {
+    constexpr auto modulus = "1000000007"_big;
+    constexpr const auto& limbs = decltype(modulus)::limbs<unsigned long long, 1000000>;
+    static_assert(limbs.size == 2 && limbs.digits[0] == 7 && limbs.digits[1] == 1000);
+
+    EXPECT_EQ(BigInt("0"_big), zero);
+    EXPECT_EQ(BigInt("-0"_big), zero);
+    EXPECT_EQ(BigInt("-10"_big), minusTen);
+    EXPECT_EQ(BigInt("000001000000000"_big), large6);
+    EXPECT_EQ(BigInt("1234567890123456789"_big), large1);
+    EXPECT_EQ(BigInt("2363683468346834683851923915823586238528368238562914012402395236582385194194"_big), large8);
+    EXPECT_EQ(BigInt(modulus) - one, BigInt(1000000006));
+}
+
+TEST_F(BigIntTest, Binary_RoundTrip) {
+    for (const BigInt& value : {zero, minusOne, large1, -large8, large10}) {
+        std::stringstream ss;
+        value.write_binary(ss);
+        EXPECT_EQ(BigInt::read_binary(ss), value);
+    }
+
+    std::stringstream truncated;
+    large10.write_binary(truncated);
+    std::string bytes = truncated.str();
+    truncated.str(bytes.substr(0, bytes.size() - 1));
+    EXPECT_THROW(BigInt::read_binary(truncated), std::invalid_argument);
+
+    std::stringstream garbage("not a bigint at all, definitely");
+    EXPECT_THROW(BigInt::read_binary(garbage), std::invalid_argument);
+}
+
+TEST_F(BigIntTest, Binary_MappedView) {
+    std::string path = ::testing::TempDir() + "bigint_mapped.bin";
+    save_binary(-large10, path);
+
+    MappedBigInt mapped(path);
+    EXPECT_TRUE(mapped.view().negative());
+    EXPECT_EQ(BigInt(mapped.view()), -large10);
+    EXPECT_EQ(load_binary<BigInt>(path), -large10);
+
+    std::stringstream printed, expected;
+    printed << mapped.view();
+    expected << -large10;
+    EXPECT_EQ(printed.str(), expected.str());
+
+    std::remove(path.c_str());
+    EXPECT_THROW(MappedBigInt{path}, std::runtime_error);
+}
+
+TEST_F(BigIntTest, IO_Stream_Input) {
+    std::stringstream ss;
+    BigInt num;
+
+    ss << "123 -456 0 -0 0000001000000000";
+    ss >> num; EXPECT_EQ(num, BigInt(123));
+    ss >> num; EXPECT_EQ(num, BigInt(-456));
+    ss >> num; EXPECT_EQ(num, zero);
+    ss >> num; EXPECT_EQ(num, zero);
+    ss >> num; EXPECT_EQ(num, large6);
+    EXPECT_TRUE(ss.eof());
+    ss.clear(); ss.str("");
+
+    ss << "  " << large10 << "\n" << -large8 << " rest";
+    ss >> num; EXPECT_EQ(num, large10);
+    ss >> num; EXPECT_EQ(num, -large8);
+    std::string rest;
+    ss >> rest; EXPECT_EQ(rest, "rest");
+    ss.clear(); ss.str("");
+
+    std::string long_digits(10000, '7');
+    ss << long_digits;
+    ss >> num; EXPECT_EQ(num, BigInt(long_digits));
+    ss.clear(); ss.str("");
+
+    num = five;
+    ss << "-";
+    ss >> num; EXPECT_TRUE(ss.fail()); EXPECT_EQ(num, five);
+    ss.clear(); ss.str("");
+
+    ss << "12a3";
+    EXPECT_THROW(ss >> num, std::invalid_argument);
+}
+
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,69 @@
+#define BIGINT_STATS
+#include "../include/bigint.h"
+#include <gtest/gtest.h>
+
+class BigIntStatsTest : public ::testing::Test {
+protected:
+    BigInt large1 = BigInt("2363683468346834683851923915823586238528368238562914012402395236582385194194");
+    BigInt large2 = BigInt("23577263587623576287356239502350827386183184348324769104");
+
+    void SetUp() override {
+        bigint_stats::reset();
+    }
+};
+
+TEST_F(BigIntStatsTest, Reset) {
+    BigInt sum = large1 + large2;
+    EXPECT_GT(bigint_stats::snapshot().limb_ops, 0);
+    bigint_stats::reset();
+    BigIntStats stats = bigint_stats::snapshot();
+    EXPECT_EQ(stats.limb_ops, 0);
+    EXPECT_EQ(stats.allocations, 0);
+    EXPECT_EQ(stats.allocated_bytes, 0);
+}
+
+TEST_F(BigIntStatsTest, Allocations) {
+    BigInt copy = large1;
+    BigInt negated = -large1;
+    BigInt absolute = negated.abs();
+    BigIntStats stats = bigint_stats::snapshot();
+    EXPECT_EQ(stats.allocations, 0);
+    EXPECT_EQ(stats.allocated_bytes, 0);
+
+    BigInt sum = large1 + large2;
+    stats = bigint_stats::snapshot();
+    EXPECT_EQ(stats.allocations, 1);
+    EXPECT_EQ(stats.allocated_bytes, 14 * sizeof(unsigned long long));
+}
+
+TEST_F(BigIntStatsTest, AlgorithmTiers) {
+    BigInt product = large1.karatsuba_multiply(large2);
+    EXPECT_EQ(bigint_stats::snapshot().karatsuba_calls, 1);
+
+    BigInt nines(std::string(600, '9'));
+    EXPECT_EQ(nines.karatsuba_multiply(nines), nines * nines);
+    bigint_stats::reset();
+    product = nines.karatsuba_multiply(nines);
+    BigIntStats stats = bigint_stats::snapshot();
+    EXPECT_GT(stats.karatsuba_calls, 1);
+    EXPECT_GT(stats.karatsuba_max_depth, 1);
+    EXPECT_EQ(stats.fft_calls, 0);
+
+    EXPECT_EQ(nines.fft_multiply(nines), product);
+    EXPECT_EQ(bigint_stats::snapshot().fft_calls, 1);
+
+    EXPECT_EQ(BigInt(100) / BigInt(7), BigInt(14));
+    EXPECT_EQ(BigInt(100) % BigInt(7), BigInt(2));
+    EXPECT_EQ(bigint_stats::snapshot().long_division_calls, 2);
+}
+
+TEST_F(BigIntStatsTest, SchoolbookLimbOps) {
+    BigInt product = large1 * large2;
+    EXPECT_GE(bigint_stats::snapshot().limb_ops, 13 * 10);
+}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,110 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_ACCUMULATOR_H
+#define FUNDAMENTAL_ALGORITHMS_2_ACCUMULATOR_H
+
+#include "basic_bigint.h"
+
+// Sums many BigInts without propagating carries on every addition. Limbs are
+// added into signed 128-bit lanes, and carries are only resolved when the
+// lanes could overflow or when the value is read.
+template<typename Int>
+class BigIntAccumulator {
+    using int128_t = bigint_detail::int128_t;
+    using uint128_t = bigint_detail::uint128_t;
+
+    static constexpr long long base = Int::base;
+    static constexpr uint128_t lane_limit = (uint128_t) 1 << 125;
+
+    std::vector<int128_t> lanes;
+    // No lane magnitude exceeds this since the last normalization.
+    uint128_t bound = 0;
+
+    void accumulate(const Int& value, long long factor) {
+        const auto& digits = value.limbs();
+        if (digits.empty() || factor == 0)
+            return;
+
+        uint128_t magnitude = factor < 0 ? (uint128_t) -(factor + 1) + 1 : (uint128_t) factor;
+        uint128_t step = magnitude * (base - 1);
+        if (bound + step > lane_limit)
+            normalize();
+        bound += step;
+
+        if (lanes.size() < digits.size())
+            lanes.resize(digits.size(), 0);
+        BIGINT_COUNT(limb_ops, digits.size());
+        int128_t signed_factor = value.isNegative != (factor < 0) ? -(int128_t) magnitude : (int128_t) magnitude;
+        for (size_t i = 0; i < digits.size(); ++i)
+            lanes[i] += signed_factor * digits[i];
+    }
+
+    static int128_t floor_divide(int128_t& value) {
+        int128_t quotient = value / base;
+        value %= base;
+        if (value < 0) {
+            value += base;
+            quotient--;
+        }
+        return quotient;
+    }
+
+public:
+    BigIntAccumulator() = default;
+    explicit BigIntAccumulator(const Int& initial) { add(initial); }
+
+    void add(const Int& value) { accumulate(value, 1); }
+    void subtract(const Int& value) { accumulate(value, -1); }
+
+    // += value * factor, the building block of dot products with small weights.
+    void multiply_add(const Int& value, long long factor) { accumulate(value, factor); }
+
+    BigIntAccumulator& operator+=(const Int& value) {
+        add(value);
+        return *this;
+    }
+
+    BigIntAccumulator& operator-=(const Int& value) {
+        subtract(value);
+        return *this;
+    }
+
+    // Brings every lane but the top one into [0, base). A negative total
+    // leaves -1 in the top lane.
+    void normalize() {
+        int128_t carry = 0;
+        for (auto& lane : lanes) {
+            lane += carry;
+            carry = floor_divide(lane);
+        }
+        while (carry != 0 && carry != -1) {
+            int128_t lane = carry;
+            carry = floor_divide(lane);
+            lanes.push_back(lane);
+        }
+        if (carry == -1)
+            lanes.push_back(-1);
+        while (!lanes.empty() && lanes.back() == 0)
+            lanes.pop_back();
+        bound = base;
+    }
+
+    Int value() {
+        normalize();
+        bool negative = !lanes.empty() && lanes.back() < 0;
+        size_t size = lanes.size() - negative;
+
+        Int result;
+        auto& digits = result.mutable_limbs();
+        digits.resize(size);
+        for (size_t i = 0; i < size; ++i)
+            digits[i] = (typename Int::limb_type) lanes[i];
+        result.remove_leading_zeros();
+        return negative ? result - Int(1).shifted((long) size) : result;
+    }
+
+    void clear() {
+        lanes.clear();
+        bound = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,2074 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_BASIC_BIGINT_H
+#define FUNDAMENTAL_ALGORITHMS_2_BASIC_BIGINT_H
+
+#include <iostream>
+#include <ranges>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <complex>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <concepts>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <optional>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+
+#include "bigint_thresholds.h"
+#include "thread_pool.h"
+
+// Counters for the BigInt hot paths. They are only updated when the header is
+// compiled with BIGINT_STATS; otherwise every counting site compiles to
+// nothing and snapshot() reports zeros.
+struct BigIntStats {
+    uint64_t limb_ops = 0;
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+    uint64_t karatsuba_calls = 0;
+    uint64_t karatsuba_max_depth = 0;
+    uint64_t fft_calls = 0;
+    uint64_t long_division_calls = 0;
+};
+
+namespace bigint_stats {
+#ifdef BIGINT_STATS
+    inline std::atomic<uint64_t> limb_ops {0};
+    inline std::atomic<uint64_t> allocations {0};
+    inline std::atomic<uint64_t> allocated_bytes {0};
+    inline std::atomic<uint64_t> karatsuba_calls {0};
+    inline std::atomic<uint64_t> karatsuba_max_depth {0};
+    inline std::atomic<uint64_t> fft_calls {0};
+    inline std::atomic<uint64_t> long_division_calls {0};
+    inline thread_local uint64_t karatsuba_depth = 0;
+
+    struct DepthGuard {
+        DepthGuard() {
+            uint64_t depth = ++karatsuba_depth;
+            uint64_t seen = karatsuba_max_depth.load(std::memory_order_relaxed);
+            while (depth > seen && !karatsuba_max_depth.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {}
+        }
+        ~DepthGuard() { --karatsuba_depth; }
+    };
+
+    template<typename T>
+    struct CountingAllocator : std::allocator<T> {
+        using value_type = T;
+
+        CountingAllocator() = default;
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            allocated_bytes.fetch_add(n * sizeof(T), std::memory_order_relaxed);
+            return std::allocator<T>::allocate(n);
+        }
+
+        template<typename U>
+        struct rebind { using other = CountingAllocator<U>; };
+    };
+
+    template<typename T>
+    using allocator = CountingAllocator<T>;
+#else
+    template<typename T>
+    using allocator = std::allocator<T>;
+#endif
+
+    inline BigIntStats snapshot() {
+        BigIntStats stats;
+#ifdef BIGINT_STATS
+        stats.limb_ops = limb_ops.load(std::memory_order_relaxed);
+        stats.allocations = allocations.load(std::memory_order_relaxed);
+        stats.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+        stats.karatsuba_calls = karatsuba_calls.load(std::memory_order_relaxed);
+        stats.karatsuba_max_depth = karatsuba_max_depth.load(std::memory_order_relaxed);
+        stats.fft_calls = fft_calls.load(std::memory_order_relaxed);
+        stats.long_division_calls = long_division_calls.load(std::memory_order_relaxed);
+#endif
+        return stats;
+    }
+
+    inline void reset() {
+#ifdef BIGINT_STATS
+        for (auto* counter : {&limb_ops, &allocations, &allocated_bytes, &karatsuba_calls,
+                              &karatsuba_max_depth, &fft_calls, &long_division_calls})
+            counter->store(0, std::memory_order_relaxed);
+#endif
+    }
+}
+
+#ifdef BIGINT_STATS
+#define BIGINT_COUNT(counter, n) bigint_stats::counter.fetch_add((n), std::memory_order_relaxed)
+#define BIGINT_TRACK_DEPTH() bigint_stats::DepthGuard bigint_depth_guard
+#else
+#define BIGINT_COUNT(counter, n) ((void) 0)
+#define BIGINT_TRACK_DEPTH() ((void) 0)
+#endif
+
+// Kernels shared by the policies. They work on magnitudes stored as limb
+// vectors, least significant limb first, without leading zero limbs.
+namespace bigint_detail {
+    __extension__ typedef unsigned __int128 uint128_t;
+    __extension__ typedef __int128 int128_t;
+
+    constexpr int block_size(unsigned long long base) {
+        int block = 0;
+        for (; base > 1; base /= 10)
+            block++;
+        return block;
+    }
+
+    constexpr bool is_power_of_ten(unsigned long long base) {
+        for (; base > 1 && base % 10 == 0; base /= 10) {}
+        return base == 1;
+    }
+
+    template<typename Limbs>
+    void trim(Limbs& limbs) {
+        while (!limbs.empty() && limbs.back() == 0)
+            limbs.pop_back();
+    }
+
+    template<typename Limbs>
+    std::strong_ordering compare(const Limbs& a, const Limbs& b) {
+        if (a.size() != b.size())
+            return a.size() <=> b.size();
+        for (size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i])
+                return a[i] <=> b[i];
+        }
+        return std::strong_ordering::equal;
+    }
+
+    // acc += x * Base^shift
+    template<auto Base, typename Limbs>
+    void add_shifted(Limbs& acc, const Limbs& x, size_t shift) {
+        if (acc.size() < x.size() + shift)
+            acc.resize(x.size() + shift, 0);
+        BIGINT_COUNT(limb_ops, x.size());
+
+        unsigned long long carry = 0;
+        size_t i = shift;
+        for (size_t j = 0; j < x.size(); ++i, ++j) {
+            unsigned long long sum = acc[i] + x[j] + carry;
+            carry = sum >= Base;
+            acc[i] = carry ? sum - Base : sum;
+        }
+        for (; carry; ++i) {
+            if (i == acc.size())
+                acc.push_back(0);
+            unsigned long long sum = acc[i] + carry;
+            carry = sum >= Base;
+            acc[i] = carry ? sum - Base : sum;
+        }
+    }
+
+    // acc -= x * Base^shift, the caller guarantees the result is not negative.
+    template<auto Base, typename Limbs>
+    void sub_shifted(Limbs& acc, const Limbs& x, size_t shift) {
+        BIGINT_COUNT(limb_ops, x.size());
+
+        unsigned long long borrow = 0;
+        size_t i = shift;
+        for (size_t j = 0; j < x.size(); ++i, ++j) {
+            unsigned long long subtrahend = x[j] + borrow;
+            borrow = acc[i] < subtrahend;
+            acc[i] = borrow ? acc[i] + Base - subtrahend : acc[i] - subtrahend;
+        }
+        for (; borrow; ++i) {
+            borrow = acc[i] == 0;
+            acc[i] = borrow ? Base - 1 : acc[i] - 1;
+        }
+        trim(acc);
+    }
+
+    template<auto Base, typename Limbs>
+    void schoolbook(const Limbs& a, const Limbs& b, Limbs& result) {
+        result.assign(a.size() + b.size(), 0);
+        BIGINT_COUNT(limb_ops, a.size() * b.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            unsigned long long carry = 0;
+            for (size_t j = 0; j < b.size(); ++j) {
+                unsigned long long current = result[i + j] + (unsigned long long) a[i] * b[j] + carry;
+                result[i + j] = current % Base;
+                carry = current / Base;
+            }
+            for (size_t k = i + b.size(); carry; ++k) {
+                unsigned long long current = result[k] + carry;
+                result[k] = current % Base;
+                carry = current / Base;
+            }
+        }
+        trim(result);
+    }
+
+    // result = a * k for a single machine word k < Base.
+    template<auto Base, typename Limbs>
+    void multiply_small(const Limbs& a, unsigned long long k, Limbs& result) {
+        result.assign(a.size() + 1, 0);
+        BIGINT_COUNT(limb_ops, a.size());
+        unsigned long long carry = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            unsigned long long current = (unsigned long long) a[i] * k + carry;
+            result[i] = current % Base;
+            carry = current / Base;
+        }
+        result[a.size()] = carry;
+        trim(result);
+    }
+
+    // Machine integers that mix with BigInts without being wrapped first.
+    template<typename T>
+    concept word = std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(unsigned long long);
+
+    template<word T>
+    constexpr bool is_negative(T value) {
+        if constexpr (std::is_signed_v<T>)
+            return value < 0;
+        return false;
+    }
+
+    template<word T>
+    unsigned long long word_magnitude(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            if (value < 0)
+                return 0ULL - (unsigned long long) value;
+        }
+        return (unsigned long long) value;
+    }
+
+    // acc += v in place for any 64-bit v.
+    template<auto Base, typename Limbs>
+    void add_word(Limbs& acc, unsigned long long v) {
+        for (size_t i = 0; v > 0; ++i) {
+            if (i == acc.size())
+                acc.push_back(0);
+            unsigned long long sum = acc[i] + v % Base;
+            v = v / Base + (sum >= Base);
+            acc[i] = sum >= Base ? sum - Base : sum;
+        }
+    }
+
+    // acc -= v in place, the caller guarantees acc >= v.
+    template<auto Base, typename Limbs>
+    void sub_word(Limbs& acc, unsigned long long v) {
+        for (size_t i = 0; v > 0; ++i) {
+            unsigned long long subtrahend = v % Base;
+            v /= Base;
+            if (acc[i] < subtrahend) {
+                acc[i] = acc[i] + Base - subtrahend;
+                v++;
+            } else {
+                acc[i] = acc[i] - subtrahend;
+            }
+        }
+        trim(acc);
+    }
+
+    // acc *= v in place. Products only go through 128 bits when v is too
+    // large for a limb product plus carry to fit in 64.
+    template<auto Base, typename Limbs>
+    void multiply_word(Limbs& acc, unsigned long long v) {
+        BIGINT_COUNT(limb_ops, acc.size());
+        if (v <= ~0ULL / (Base + 1)) {
+            unsigned long long carry = 0;
+            for (auto& limb : acc) {
+                unsigned long long current = limb * v + carry;
+                limb = current % Base;
+                carry = current / Base;
+            }
+            for (; carry > 0; carry /= Base)
+                acc.push_back(carry % Base);
+        } else {
+            uint128_t carry = 0;
+            for (auto& limb : acc) {
+                uint128_t current = (uint128_t) limb * v + carry;
+                limb = (unsigned long long) (current % Base);
+                carry = current / Base;
+            }
+            for (; carry > 0; carry /= Base)
+                acc.push_back((unsigned long long) (carry % Base));
+        }
+        trim(acc);
+    }
+
+    // acc /= v in place for v > 0; returns the remainder.
+    template<auto Base, typename Limbs>
+    unsigned long long divide_word(Limbs& acc, unsigned long long v) {
+        BIGINT_COUNT(limb_ops, acc.size());
+        unsigned long long remainder = 0;
+        if (v <= ~0ULL / Base) {
+            for (size_t i = acc.size(); i-- > 0;) {
+                unsigned long long current = remainder * Base + acc[i];
+                acc[i] = current / v;
+                remainder = current % v;
+            }
+        } else {
+            for (size_t i = acc.size(); i-- > 0;) {
+                uint128_t current = (uint128_t) remainder * Base + acc[i];
+                acc[i] = (unsigned long long) (current / v);
+                remainder = (unsigned long long) (current % v);
+            }
+        }
+        trim(acc);
+        return remainder;
+    }
+
+    // acc mod v for v > 0 without touching acc.
+    template<auto Base, typename Limbs>
+    unsigned long long modulo_word(const Limbs& acc, unsigned long long v) {
+        uint128_t remainder = 0;
+        for (size_t i = acc.size(); i-- > 0;)
+            remainder = (remainder * Base + acc[i]) % v;
+        return (unsigned long long) remainder;
+    }
+
+    // The value of limbs when it fits in 128 bits.
+    template<auto Base, typename Limbs>
+    std::optional<uint128_t> to_uint128(const Limbs& limbs) {
+        uint128_t value = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            if (value > (~(uint128_t) 0 - limbs[i]) / Base)
+                return std::nullopt;
+            value = value * Base + limbs[i];
+        }
+        return value;
+    }
+
+    // result = a * b for a at least twice as long as b. a is cut into chunks
+    // of b's length, every chunk goes through the balanced kernel and its
+    // product is added into result in place.
+    template<auto Base, typename Limbs, typename Balanced>
+    void multiply_unbalanced(const Limbs& a, const Limbs& b, Limbs& result, Balanced balanced) {
+        result.assign(a.size() + b.size(), 0);
+        Limbs chunk, product;
+        for (size_t start = 0; start < a.size(); start += b.size()) {
+            chunk.assign(a.begin() + (long) start, a.begin() + (long) std::min(start + b.size(), a.size()));
+            trim(chunk);
+            balanced(chunk, b, product);
+            add_shifted<Base>(result, product, start);
+        }
+        trim(result);
+    }
+
+    using fft_complex = std::complex<long double>;
+
+    // Roots of unity and the bit-reversal permutation for one transform size.
+    struct FftTables {
+        std::vector<fft_complex> roots; // roots[k] = exp(2 pi i k / n) for k < n / 2
+        std::vector<uint32_t> reversed;
+    };
+
+    // Built once per size on first use and only read afterwards, so threads
+    // share them without locking.
+    inline const FftTables& fft_tables(size_t n) {
+        static std::array<std::once_flag, 64> once;
+        static std::array<std::unique_ptr<FftTables>, 64> tables;
+        int log = std::countr_zero(n);
+        std::call_once(once[log], [&] {
+            auto built = std::make_unique<FftTables>();
+            built->roots.resize(n / 2);
+            for (size_t k = 0; k < n / 2; ++k)
+                built->roots[k] = std::polar(1.0L, 2 * std::numbers::pi_v<long double> * (long double) k / (long double) n);
+            built->reversed.assign(n, 0);
+            for (size_t i = 1; i < n; ++i)
+                built->reversed[i] = (uint32_t) ((built->reversed[i >> 1] >> 1) | (i & 1 ? n >> 1 : 0));
+            tables[log] = std::move(built);
+        });
+        return *tables[log];
+    }
+
+    template<typename Limbs>
+    Limbs power_of_base(size_t exponent) {
+        Limbs result(exponent, 0);
+        result.push_back(1);
+        return result;
+    }
+
+    template<typename Limbs>
+    Limbs slice(const Limbs& limbs, size_t start, size_t stop) {
+        start = std::min(start, limbs.size());
+        stop = std::min(stop, limbs.size());
+        Limbs result(limbs.begin() + (long) start, limbs.begin() + (long) stop);
+        trim(result);
+        return result;
+    }
+
+    // Four independent multiply-xor lanes over the limbs, so consecutive
+    // limbs do not wait on each other and the loop vectorizes; the lanes
+    // and the length are folded together at the end. Never returns 0.
+    template<typename Limbs>
+    size_t hash_limbs(const Limbs& limbs) {
+        constexpr uint64_t multiplier = 0xff51afd7ed558ccdULL;
+        uint64_t lanes[4] = {0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL, 0x94d049bb133111ebULL,
+                             0x2545f4914f6cdd1dULL};
+        size_t n = limbs.size(), i = 0;
+        for (; i + 4 <= n; i += 4) {
+            for (size_t lane = 0; lane < 4; ++lane)
+                lanes[lane] = (lanes[lane] ^ limbs[i + lane]) * multiplier;
+        }
+        for (size_t lane = 0; i < n; ++i, ++lane)
+            lanes[lane] = (lanes[lane] ^ limbs[i]) * multiplier;
+
+        uint64_t h = n * 0xc4ceb9fe1a85ec53ULL;
+        for (uint64_t lane : lanes) {
+            h = (h ^ lane ^ (lane >> 29)) * multiplier;
+            h ^= h >> 32;
+        }
+        return h == 0 ? 1 : (size_t) h;
+    }
+
+    // Lazily computed hash that travels with copies; 0 means not computed.
+    class HashCache {
+        mutable std::atomic<size_t> value {0};
+
+    public:
+        HashCache() = default;
+        HashCache(const HashCache& other) : value(other.get()) {}
+        HashCache(HashCache&& other) noexcept : value(other.value.exchange(0, std::memory_order_relaxed)) {}
+
+        HashCache& operator=(const HashCache& other) {
+            set(other.get());
+            return *this;
+        }
+
+        HashCache& operator=(HashCache&& other) noexcept {
+            set(other.value.exchange(0, std::memory_order_relaxed));
+            return *this;
+        }
+
+        [[nodiscard]] size_t get() const { return value.load(std::memory_order_relaxed); }
+        void set(size_t hash) const { value.store(hash, std::memory_order_relaxed); }
+    };
+}
+
+// Multiplication policies. Each one multiplies two magnitudes into result,
+// which never aliases the operands.
+struct SchoolbookMultiply {
+    template<auto Base, typename Limbs>
+    static void multiply(const Limbs& a, const Limbs& b, Limbs& result) {
+        bigint_detail::schoolbook<Base>(a, b, result);
+    }
+};
+
+// Karatsuba down to operands shorter than From limbs, which go to schoolbook.
+// KaratsubaMultiply uses the same crossover as DispatchMultiply.
+template<size_t From = BIGINT_KARATSUBA_FROM>
+struct BasicKaratsubaMultiply {
+    static_assert(From >= 2, "single limbs cannot be split");
+    static constexpr size_t threshold = From;
+
+    template<auto Base, typename Limbs>
+    static void multiply(const Limbs& a, const Limbs& b, Limbs& result) {
+        BIGINT_COUNT(karatsuba_calls, 1);
+        BIGINT_TRACK_DEPTH();
+
+        if (a.empty() || b.empty()) {
+            result.clear();
+            return;
+        }
+        if (std::min(a.size(), b.size()) < From) {
+            bigint_detail::schoolbook<Base>(a, b, result);
+            return;
+        }
+        const Limbs& longer = a.size() >= b.size() ? a : b;
+        const Limbs& shorter = a.size() >= b.size() ? b : a;
+        if (longer.size() >= 2 * shorter.size()) {
+            bigint_detail::multiply_unbalanced<Base>(longer, shorter, result,
+                                                     [](const Limbs& x, const Limbs& y, Limbs& out) {
+                multiply<Base>(x, y, out);
+            });
+            return;
+        }
+
+        size_t mid = (std::max(a.size(), b.size()) + 1) / 2;
+
+        Limbs a_low = bigint_detail::slice(a, 0, mid);
+        Limbs a_high = bigint_detail::slice(a, mid, a.size());
+        Limbs b_low = bigint_detail::slice(b, 0, mid);
+        Limbs b_high = bigint_detail::slice(b, mid, b.size());
+
+        Limbs low, high, middle;
+        multiply<Base>(a_low, b_low, low);
+        multiply<Base>(a_high, b_high, high);
+
+        bigint_detail::add_shifted<Base>(a_low, a_high, 0);
+        bigint_detail::add_shifted<Base>(b_low, b_high, 0);
+        multiply<Base>(a_low, b_low, middle);
+        bigint_detail::sub_shifted<Base>(middle, low, 0);
+        bigint_detail::sub_shifted<Base>(middle, high, 0);
+
+        result = std::move(low);
+        bigint_detail::add_shifted<Base>(result, middle, mid);
+        bigint_detail::add_shifted<Base>(result, high, 2 * mid);
+        bigint_detail::trim(result);
+    }
+};
+
+using KaratsubaMultiply = BasicKaratsubaMultiply<>;
+
+// FFT over complex<long double>. With PackRealInput both real operands of a
+// balanced product share one complex transform, so it takes two transforms
+// instead of three.
+template<bool PackRealInput = true>
+struct BasicFftMultiply {
+    using complex = bigint_detail::fft_complex;
+
+    static void fft(std::vector<complex>& a) {
+        size_t n = a.size();
+        BIGINT_COUNT(limb_ops, n * std::bit_width(n) / 2);
+        const bigint_detail::FftTables& tables = bigint_detail::fft_tables(n);
+        for (size_t i = 1; i < n; ++i) {
+            if (i < tables.reversed[i])
+                std::swap(a[i], a[tables.reversed[i]]);
+        }
+
+        for (size_t len = 2; len <= n; len <<= 1) {
+            size_t stride = n / len;
+            for (size_t i = 0; i < n; i += len) {
+                for (size_t j = 0; j < len / 2; ++j) {
+                    complex u = a[i + j];
+                    complex v = a[i + j + len / 2] * tables.roots[j * stride];
+                    a[i + j] = u + v;
+                    a[i + j + len / 2] = u - v;
+                }
+            }
+        }
+    }
+
+    template<typename Limbs>
+    static std::vector<complex> transform(const Limbs& x, size_t fft_size) {
+        std::vector<complex> fx(fft_size, complex(0));
+        for (size_t i = 0; i < x.size(); ++i)
+            fx[i] = static_cast<long double>(x[i]);
+        fft(fx);
+        return fx;
+    }
+
+    // result = inverse transform of fa, with carries propagated.
+    template<auto Base, typename Limbs>
+    static void inverse(std::vector<complex>& fa, Limbs& result) {
+        size_t fft_size = fa.size();
+        for (auto& x : fa)
+            x = std::conj(x);
+        fft(fa);
+        for (auto& x : fa)
+            x = std::conj(x);
+        for (auto& x : fa)
+            x /= static_cast<long double>(fft_size);
+
+        result.clear();
+        long long carry = 0;
+        for (size_t i = 0; i < fft_size || carry > 0; ++i) {
+            long long value = carry;
+            if (i < fft_size)
+                value += std::llround(fa[i].real());
+            result.push_back(value % static_cast<long long>(Base));
+            carry = value / static_cast<long long>(Base);
+        }
+        bigint_detail::trim(result);
+    }
+
+    template<auto Base, typename Limbs>
+    static void multiply_transformed(std::vector<complex> fa, const std::vector<complex>& fb, Limbs& result) {
+        for (size_t i = 0; i < fa.size(); ++i)
+            fa[i] *= fb[i];
+        inverse<Base>(fa, result);
+    }
+
+    // z = a + i b, then A_k = (Z_k + conj Z_{n-k}) / 2, B_k = (Z_k - conj Z_{n-k}) / 2i.
+    template<auto Base, typename Limbs>
+    static void multiply_packed(const Limbs& a, const Limbs& b, size_t fft_size, Limbs& result) {
+        std::vector<complex> fz(fft_size, complex(0));
+        for (size_t i = 0; i < a.size(); ++i)
+            fz[i].real(static_cast<long double>(a[i]));
+        for (size_t i = 0; i < b.size(); ++i)
+            fz[i].imag(static_cast<long double>(b[i]));
+        fft(fz);
+
+        std::vector<complex> product(fft_size);
+        for (size_t k = 0; k < fft_size; ++k) {
+            complex z = fz[k], mirrored = std::conj(fz[(fft_size - k) & (fft_size - 1)]);
+            product[k] = (z + mirrored) * (z - mirrored) * complex(0, -0.25L);
+        }
+        inverse<Base>(product, result);
+    }
+
+    template<auto Base, typename Limbs>
+    static void multiply(const Limbs& a, const Limbs& b, Limbs& result) {
+        result.clear();
+        if (a.empty() || b.empty())
+            return;
+        BIGINT_COUNT(fft_calls, 1);
+
+        // A much longer operand is multiplied chunk by chunk, so the transform
+        // only has to fit one chunk and the shorter one is transformed once.
+        const Limbs& longer = a.size() >= b.size() ? a : b;
+        const Limbs& shorter = a.size() >= b.size() ? b : a;
+        bool unbalanced = longer.size() >= 2 * shorter.size();
+        size_t total_size = (unbalanced ? shorter.size() : longer.size()) + shorter.size();
+        size_t fft_size = std::bit_ceil(total_size);
+
+        if (!unbalanced && PackRealInput) {
+            multiply_packed<Base>(longer, shorter, fft_size, result);
+            return;
+        }
+        std::vector<complex> fb = transform(shorter, fft_size);
+        if (!unbalanced) {
+            multiply_transformed<Base>(transform(longer, fft_size), fb, result);
+            return;
+        }
+        bigint_detail::multiply_unbalanced<Base>(longer, shorter, result,
+                                                 [&](const Limbs& chunk, const Limbs&, Limbs& out) {
+            multiply_transformed<Base>(transform(chunk, fft_size), fb, out);
+        });
+    }
+};
+
+using FftMultiply = BasicFftMultiply<>;
+
+// Runs the top levels of a Karatsuba split, or the chunks of an unbalanced
+// product, as tasks on the shared thread pool. Operands shorter than Cutoff
+// limbs go to Inner on the calling thread. Every path is exact, so results
+// match the serial policies limb for limb.
+template<typename Inner = KaratsubaMultiply, size_t Cutoff = 4096>
+struct ParallelMultiply {
+    static constexpr size_t cutoff = Cutoff;
+
+    template<auto Base, typename Limbs>
+    static void multiply(const Limbs& a, const Limbs& b, Limbs& result) {
+        ThreadPool& pool = ThreadPool::shared();
+        const Limbs& longer = a.size() >= b.size() ? a : b;
+        const Limbs& shorter = a.size() >= b.size() ? b : a;
+        if (shorter.size() < Cutoff) {
+            Inner::template multiply<Base>(a, b, result);
+            return;
+        }
+
+        std::vector<ThreadPool::Handle> handles;
+        if (longer.size() >= 2 * shorter.size()) {
+            size_t chunks = (longer.size() + shorter.size() - 1) / shorter.size();
+            std::vector<Limbs> products(chunks);
+            // Queued tasks refer to products and the operands, so a failed
+            // submit still waits for them before the frame unwinds.
+            handles.reserve(chunks);
+            try {
+                for (size_t i = 0; i < chunks; ++i) {
+                    handles.push_back(pool.submit([&, i] {
+                        size_t start = i * shorter.size();
+                        multiply<Base>(bigint_detail::slice(longer, start, start + shorter.size()), shorter,
+                                       products[i]);
+                    }));
+                }
+            } catch (...) {
+                ThreadPool::wait_all(handles);
+                throw;
+            }
+            ThreadPool::wait_all(handles);
+
+            result.assign(longer.size() + shorter.size(), 0);
+            for (size_t i = 0; i < chunks; ++i)
+                bigint_detail::add_shifted<Base>(result, products[i], i * shorter.size());
+            bigint_detail::trim(result);
+            return;
+        }
+
+        size_t mid = (longer.size() + 1) / 2;
+        Limbs a_low = bigint_detail::slice(a, 0, mid);
+        Limbs a_high = bigint_detail::slice(a, mid, a.size());
+        Limbs b_low = bigint_detail::slice(b, 0, mid);
+        Limbs b_high = bigint_detail::slice(b, mid, b.size());
+
+        Limbs low, high, middle;
+        handles.reserve(2);
+        handles.push_back(pool.submit([&] { multiply<Base>(a_high, b_high, high); }));
+        try {
+            handles.push_back(pool.submit([&] {
+                Limbs a_sum = a_low, b_sum = b_low;
+                bigint_detail::add_shifted<Base>(a_sum, a_high, 0);
+                bigint_detail::add_shifted<Base>(b_sum, b_high, 0);
+                multiply<Base>(a_sum, b_sum, middle);
+            }));
+            multiply<Base>(a_low, b_low, low);
+        } catch (...) {
+            ThreadPool::wait_all(handles);
+            throw;
+        }
+        ThreadPool::wait_all(handles);
+
+        bigint_detail::sub_shifted<Base>(middle, low, 0);
+        bigint_detail::sub_shifted<Base>(middle, high, 0);
+        result = std::move(low);
+        bigint_detail::add_shifted<Base>(result, middle, mid);
+        bigint_detail::add_shifted<Base>(result, high, 2 * mid);
+        bigint_detail::trim(result);
+    }
+};
+
+// Schönhage–Strassen over the ring Z/(Base^K + 1). Base^K = -1 there, so
+// Base is a 2K-th root of unity and every twiddle factor is a power of Base:
+// multiplying by it is a limb shift with a negated wrap-around, and the whole
+// transform stays in exact integer arithmetic. Pointwise products recurse
+// until they drop below Threshold limbs and go to Inner.
+template<typename Inner = KaratsubaMultiply, size_t Threshold = 4096>
+struct SchonhageStrassenMultiply {
+    static constexpr size_t threshold = Threshold;
+
+    // Residues modulo N = Base^K + 1, kept in [0, N).
+    template<auto Base, typename Limbs>
+    struct Ring {
+        size_t K;
+        Limbs N;
+
+        explicit Ring(size_t K) : K(K), N(bigint_detail::power_of_base<Limbs>(K)) {
+            N[0] = 1;
+        }
+
+        void add(Limbs& x, const Limbs& y) const {
+            bigint_detail::add_shifted<Base>(x, y, 0);
+            if (bigint_detail::compare(x, N) != std::strong_ordering::less)
+                bigint_detail::sub_shifted<Base>(x, N, 0);
+        }
+
+        // x - y into x.
+        void subtract(Limbs& x, const Limbs& y) const {
+            if (bigint_detail::compare(x, y) == std::strong_ordering::less)
+                bigint_detail::add_shifted<Base>(x, N, 0);
+            bigint_detail::sub_shifted<Base>(x, y, 0);
+        }
+
+        void negate(Limbs& x) const {
+            if (x.empty())
+                return;
+            Limbs difference = N;
+            bigint_detail::sub_shifted<Base>(difference, x, 0);
+            x = std::move(difference);
+        }
+
+        // x * Base^e with x = q * Base^(K-e) + r, which is r * Base^e - q.
+        Limbs shift(const Limbs& x, size_t e) const {
+            e %= 2 * K;
+            bool negative = e >= K;
+            e %= K;
+            Limbs result = bigint_detail::slice(x, 0, K - e);
+            if (!result.empty())
+                result.insert(result.begin(), e, 0);
+            subtract(result, bigint_detail::slice(x, K - e, x.size()));
+            if (negative)
+                negate(result);
+            return result;
+        }
+
+        // x mod N for x < N^2: low K limbs minus the rest.
+        void reduce(Limbs& x) const {
+            Limbs high = bigint_detail::slice(x, K, x.size());
+            x.resize(std::min(x.size(), K));
+            bigint_detail::trim(x);
+            if (bigint_detail::compare(high, N) != std::strong_ordering::less)
+                bigint_detail::sub_shifted<Base>(high, N, 0);
+            subtract(x, high);
+        }
+
+        // x / 2; N is odd, so an odd x becomes x + N first.
+        void halve(Limbs& x) const {
+            if (!x.empty() && x[0] % 2 != 0)
+                bigint_detail::add_shifted<Base>(x, N, 0);
+            unsigned long long remainder = 0;
+            for (size_t i = x.size(); i-- > 0;) {
+                unsigned long long current = remainder * Base + x[i];
+                x[i] = current / 2;
+                remainder = current % 2;
+            }
+            bigint_detail::trim(x);
+        }
+    };
+
+    // Cyclic transform of length L with root Base^(2K/L), or its inverse
+    // without the 1/L factor.
+    template<auto Base, typename Limbs>
+    static void transform(std::vector<Limbs>& a, const Ring<Base, Limbs>& ring, bool invert) {
+        size_t L = a.size();
+        for (size_t i = 1, j = 0; i < L; ++i) {
+            size_t bit = L >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if (i < j)
+                std::swap(a[i], a[j]);
+        }
+
+        for (size_t len = 2; len <= L; len <<= 1) {
+            size_t step = 2 * ring.K / len;
+            for (size_t i = 0; i < L; i += len) {
+                for (size_t j = 0; j < len / 2; ++j) {
+                    size_t exponent = invert ? 2 * ring.K - j * step : j * step;
+                    Limbs v = ring.shift(a[i + j + len / 2], exponent);
+                    Limbs u = a[i + j];
+                    ring.add(a[i + j], v);
+                    ring.subtract(u, v);
+                    a[i + j + len / 2] = std::move(u);
+                }
+            }
+        }
+    }
+
+    template<auto Base, typename Limbs>
+    static void multiply(const Limbs& a, const Limbs& b, Limbs& result) {
+        if (a.empty() || b.empty()) {
+            result.clear();
+            return;
+        }
+        if (std::min(a.size(), b.size()) < Threshold) {
+            Inner::template multiply<Base>(a, b, result);
+            return;
+        }
+
+        // L pieces of M limbs hold the product without wrapping around, and
+        // a coefficient, at most L * Base^2M, fits below Base^K.
+        size_t n = a.size() + b.size();
+        size_t L = std::max<size_t>(4, size_t(1) << ((std::bit_width(n - 1) + 1) / 2));
+        size_t M = (n + L - 1) / L;
+        auto pieces = [&](size_t size) { return (size + M - 1) / M; };
+        while (pieces(a.size()) + pieces(b.size()) - 1 > L)
+            M++;
+        size_t K = 2 * M + 1;
+        for (unsigned long long power = Base; power <= L; power *= Base)
+            K++;
+        K = (K + L / 2 - 1) / (L / 2) * (L / 2);
+        if (K >= std::min(a.size(), b.size())) {
+            // Pointwise products would be no shorter than the operands.
+            Inner::template multiply<Base>(a, b, result);
+            return;
+        }
+        Ring<Base, Limbs> ring(K);
+
+        auto split = [&](const Limbs& x) {
+            std::vector<Limbs> parts(L);
+            for (size_t i = 0; i * M < x.size(); ++i)
+                parts[i] = bigint_detail::slice(x, i * M, (i + 1) * M);
+            transform(parts, ring, false);
+            return parts;
+        };
+        std::vector<Limbs> fa = split(a), fb = split(b);
+        for (size_t i = 0; i < L; ++i) {
+            Limbs product;
+            multiply<Base>(fa[i], fb[i], product);
+            ring.reduce(product);
+            fa[i] = std::move(product);
+        }
+        transform(fa, ring, true);
+
+        result.assign(n, 0);
+        for (size_t i = 0; i < L; ++i) {
+            for (size_t s = L; s > 1; s >>= 1)
+                ring.halve(fa[i]);
+            bigint_detail::add_shifted<Base>(result, fa[i], i * M);
+        }
+        bigint_detail::trim(result);
+    }
+};
+
+namespace bigint_detail {
+    // The tier choice behind DispatchMultiply. The tuner reuses it with the
+    // Karatsuba and Schönhage–Strassen instances it is measuring.
+    template<auto Base, typename Karatsuba, typename Ssa, typename Limbs>
+    void dispatch_multiply(const Limbs& a, const Limbs& b, Limbs& result, size_t karatsuba_from,
+                           size_t fft_from, size_t ssa_from) {
+        constexpr bool fft_exact = Base <= 1000000;
+
+        size_t shorter = std::min(a.size(), b.size());
+        if (shorter < karatsuba_from)
+            schoolbook<Base>(a, b, result);
+        else if (shorter < fft_from || (!fft_exact && shorter < ssa_from))
+            Karatsuba::template multiply<Base>(a, b, result);
+        else if (shorter < ssa_from)
+            FftMultiply::multiply<Base>(a, b, result);
+        else
+            Ssa::template multiply<Base>(a, b, result);
+    }
+}
+
+// Picks the multiplication tier by the length of the shorter operand:
+// schoolbook, Karatsuba, FFT and Schönhage–Strassen from SsaFrom limbs on.
+// The FFT tier is skipped for bases above 10^6, where long double products
+// are no longer exact.
+template<size_t KaratsubaFrom = BIGINT_KARATSUBA_FROM, size_t FftFrom = BIGINT_FFT_FROM,
+         size_t SsaFrom = BIGINT_SSA_FROM>
+struct DispatchMultiply {
+    static constexpr size_t karatsuba_from = KaratsubaFrom;
+    static constexpr size_t fft_from = FftFrom;
+    static constexpr size_t ssa_from = SsaFrom;
+
+    using karatsuba_policy = BasicKaratsubaMultiply<KaratsubaFrom>;
+
+    template<auto Base>
+    using ssa_policy = SchonhageStrassenMultiply<std::conditional_t<Base <= 1000000, FftMultiply, karatsuba_policy>,
+                                                 SsaFrom>;
+
+    template<auto Base, typename Limbs>
+    static void multiply(const Limbs& a, const Limbs& b, Limbs& result) {
+        bigint_detail::dispatch_multiply<Base, karatsuba_policy, ssa_policy<Base>>(a, b, result, KaratsubaFrom,
+                                                                                  FftFrom, SsaFrom);
+    }
+};
+
+// Division policies. Each one divides magnitude a by non-zero magnitude b.
+struct LongDivision {
+    template<auto Base, typename Limbs>
+    static void divide(const Limbs& a, const Limbs& b, Limbs& quotient, Limbs& remainder) {
+        BIGINT_COUNT(long_division_calls, 1);
+
+        quotient.assign(a.size(), 0);
+        remainder.clear();
+        for (size_t i = a.size(); i-- > 0;) {
+            remainder.insert(remainder.begin(), a[i]);
+            bigint_detail::trim(remainder);
+            unsigned long long q_i = 0;
+            while (bigint_detail::compare(remainder, b) != std::strong_ordering::less) {
+                bigint_detail::sub_shifted<Base>(remainder, b, 0);
+                q_i++;
+            }
+            quotient[i] = q_i;
+        }
+        bigint_detail::trim(quotient);
+    }
+};
+
+// Schoolbook division: every quotient limb is estimated from the two leading
+// limbs of the divisor, which is off by at most two, and then corrected.
+struct SchoolbookDivision {
+    template<auto Base, typename Limbs>
+    static void divide(const Limbs& a, const Limbs& b, Limbs& quotient, Limbs& remainder) {
+        using bigint_detail::uint128_t;
+        quotient.assign(a.size(), 0);
+        remainder.clear();
+
+        if (b.size() == 1) {
+            unsigned long long rem = 0;
+            for (size_t i = a.size(); i-- > 0;) {
+                unsigned long long current = rem * Base + a[i];
+                quotient[i] = current / b[0];
+                rem = current % b[0];
+            }
+            if (rem > 0)
+                remainder.push_back(rem);
+            bigint_detail::trim(quotient);
+            return;
+        }
+
+        size_t m = b.size();
+        uint128_t divisor_top = (uint128_t) b[m - 1] * Base + b[m - 2];
+        Limbs product;
+        for (size_t i = a.size(); i-- > 0;) {
+            remainder.insert(remainder.begin(), a[i]);
+            bigint_detail::trim(remainder);
+            if (remainder.size() < m)
+                continue;
+
+            uint128_t top = (uint128_t) remainder[m - 1] * Base + remainder[m - 2];
+            if (remainder.size() > m)
+                top += (uint128_t) remainder[m] * Base * Base;
+            auto q_i = (unsigned long long) std::min<uint128_t>(top / divisor_top, Base - 1);
+
+            bigint_detail::multiply_small<Base>(b, q_i, product);
+            while (bigint_detail::compare(product, remainder) == std::strong_ordering::greater) {
+                q_i--;
+                bigint_detail::sub_shifted<Base>(product, b, 0);
+            }
+            bigint_detail::sub_shifted<Base>(remainder, product, 0);
+            while (bigint_detail::compare(remainder, b) != std::strong_ordering::less) {
+                q_i++;
+                bigint_detail::sub_shifted<Base>(remainder, b, 0);
+            }
+            quotient[i] = q_i;
+        }
+        bigint_detail::trim(quotient);
+    }
+};
+
+// Division through a Newton reciprocal of the divisor, so it costs a few
+// multiplications with MulPolicy instead of a quadratic number of limb
+// operations. Every estimate is kept below the true value, which lets all
+// intermediate results stay unsigned; a short correction loop finishes each
+// step.
+template<typename MulPolicy = KaratsubaMultiply>
+struct NewtonDivision {
+    static constexpr size_t threshold = 32;
+
+    // floor(Base^(2L) / c) for c with L limbs.
+    template<auto Base, typename Limbs>
+    static Limbs reciprocal(const Limbs& c) {
+        size_t L = c.size();
+        Limbs one(1, 1);
+        if (L <= threshold) {
+            Limbs quotient, remainder;
+            SchoolbookDivision::divide<Base>(bigint_detail::power_of_base<Limbs>(2 * L), c, quotient, remainder);
+            return quotient;
+        }
+
+        // Reciprocal of the rounded-up leading half, which underestimates
+        // the full reciprocal, then one Newton step x += x * (B^2L - c * x) / B^2L.
+        size_t h = L / 2 + 2;
+        Limbs c_high = bigint_detail::slice(c, L - h, L);
+        bigint_detail::add_shifted<Base>(c_high, one, 0);
+        Limbs x = c_high.size() > h ? bigint_detail::power_of_base<Limbs>(h) : reciprocal<Base>(c_high);
+        x.insert(x.begin(), L - h, 0);
+
+        Limbs product, error, step;
+        MulPolicy::template multiply<Base>(c, x, product);
+        error = bigint_detail::power_of_base<Limbs>(2 * L);
+        bigint_detail::sub_shifted<Base>(error, product, 0);
+        MulPolicy::template multiply<Base>(x, error, step);
+        bigint_detail::add_shifted<Base>(x, bigint_detail::slice(step, 2 * L, step.size()), 0);
+
+        MulPolicy::template multiply<Base>(c, x, product);
+        Limbs remainder = bigint_detail::power_of_base<Limbs>(2 * L);
+        bigint_detail::sub_shifted<Base>(remainder, product, 0);
+        while (bigint_detail::compare(remainder, c) != std::strong_ordering::less) {
+            bigint_detail::sub_shifted<Base>(remainder, c, 0);
+            bigint_detail::add_shifted<Base>(x, one, 0);
+        }
+        return x;
+    }
+
+    // floor(a / b) given inverse = reciprocal(b) and a < Base^(2 * len(b)).
+    template<auto Base, typename Limbs>
+    static void divide_by_reciprocal(const Limbs& a, const Limbs& b, const Limbs& inverse, size_t shift,
+                                     Limbs& quotient, Limbs& remainder) {
+        Limbs one(1, 1), product;
+        MulPolicy::template multiply<Base>(a, inverse, product);
+        quotient = bigint_detail::slice(product, shift, product.size());
+        MulPolicy::template multiply<Base>(quotient, b, product);
+        remainder = a;
+        bigint_detail::sub_shifted<Base>(remainder, product, 0);
+        while (bigint_detail::compare(remainder, b) != std::strong_ordering::less) {
+            bigint_detail::sub_shifted<Base>(remainder, b, 0);
+            bigint_detail::add_shifted<Base>(quotient, one, 0);
+        }
+    }
+
+    template<auto Base, typename Limbs>
+    static void divide(const Limbs& a, const Limbs& b, Limbs& quotient, Limbs& remainder) {
+        if (bigint_detail::compare(a, b) == std::strong_ordering::less) {
+            quotient.clear();
+            remainder = a;
+            return;
+        }
+
+        size_t n = a.size(), m = b.size();
+        if (m <= threshold || n - m <= threshold) {
+            SchoolbookDivision::divide<Base>(a, b, quotient, remainder);
+            return;
+        }
+
+        // A long divisor only matters through its leading limbs: divide by
+        // those (rounded up, so the quotient is never too large) and fix the
+        // result against the full divisor.
+        size_t k = n - m + 1;
+        if (m > k + 1) {
+            size_t s = m - (k + 1);
+            Limbs a_high = bigint_detail::slice(a, s, n);
+            Limbs b_high = bigint_detail::slice(b, s, m);
+            Limbs one(1, 1), unused;
+            bigint_detail::add_shifted<Base>(b_high, one, 0);
+            Limbs inverse = reciprocal<Base>(b_high);
+            divide_by_reciprocal<Base>(a_high, b_high, inverse, 2 * b_high.size(), quotient, unused);
+
+            Limbs product;
+            MulPolicy::template multiply<Base>(quotient, b, product);
+            remainder = a;
+            bigint_detail::sub_shifted<Base>(remainder, product, 0);
+            while (bigint_detail::compare(remainder, b) != std::strong_ordering::less) {
+                bigint_detail::sub_shifted<Base>(remainder, b, 0);
+                bigint_detail::add_shifted<Base>(quotient, one, 0);
+            }
+            return;
+        }
+
+        // A long dividend is consumed m limbs at a time, like schoolbook
+        // division with limbs of Base^m, reusing one reciprocal.
+        Limbs inverse = reciprocal<Base>(b);
+        quotient.assign(n, 0);
+        remainder.clear();
+        Limbs current, q_block;
+        for (size_t pos = n; pos > 0;) {
+            size_t len = std::min(m, pos);
+            pos -= len;
+            current.assign(a.begin() + (long) pos, a.begin() + (long) (pos + len));
+            current.insert(current.end(), remainder.begin(), remainder.end());
+            bigint_detail::trim(current);
+
+            divide_by_reciprocal<Base>(current, b, inverse, 2 * m, q_block, remainder);
+            std::copy(q_block.begin(), q_block.end(), quotient.begin() + (long) pos);
+        }
+        bigint_detail::trim(quotient);
+    }
+};
+
+// Schoolbook division while the divisor or the quotient is short, Newton
+// division over MulPolicy from NewtonFrom limbs on.
+template<size_t NewtonFrom = BIGINT_NEWTON_FROM, typename MulPolicy = DispatchMultiply<>>
+struct DispatchDivision {
+    static constexpr size_t newton_from = NewtonFrom;
+
+    using newton_policy = NewtonDivision<MulPolicy>;
+
+    template<auto Base, typename Limbs>
+    static void divide(const Limbs& a, const Limbs& b, Limbs& quotient, Limbs& remainder) {
+        if (b.size() < NewtonFrom || a.size() < b.size() + NewtonFrom)
+            SchoolbookDivision::divide<Base>(a, b, quotient, remainder);
+        else
+            newton_policy::template divide<Base>(a, b, quotient, remainder);
+    }
+};
+
+template<size_t N>
+struct FixedString {
+    char value[N] {};
+
+    constexpr FixedString(const char (&str)[N]) {
+        std::copy_n(str, N, value);
+    }
+
+    [[nodiscard]] constexpr size_t length() const { return N - 1; }
+};
+
+// Fixed-width BigInt value parsed and normalized during compilation. It is
+// stored in read-only data and turned into a BigInt by a plain limb copy,
+// without going through the string constructor.
+template<typename LimbT, size_t Limbs>
+struct BigIntConstant {
+    std::array<LimbT, Limbs> digits {};
+    size_t size = 0;
+    bool isNegative = false;
+
+    template<auto Base, size_t N>
+    static consteval BigIntConstant parse(const FixedString<N>& str) {
+        BigIntConstant result;
+        size_t index = 0;
+        if (str.length() > 0 && str.value[0] == '-') {
+            index++;
+            result.isNegative = true;
+        }
+        if (index == str.length())
+            throw std::invalid_argument("Literal contains no digits");
+
+        unsigned long long temp = 0;
+        unsigned long long multiplier = 1;
+        int temp_size = 0;
+        for (size_t end = str.length(); end > index; end--) {
+            char c = str.value[end - 1];
+            if (c < '0' || c > '9')
+                throw std::invalid_argument("Literal contains non-digit characters");
+            temp += (c - '0') * multiplier;
+            multiplier *= 10;
+            temp_size++;
+            if (temp_size == bigint_detail::block_size(Base)) {
+                result.digits[result.size++] = temp;
+                temp = 0;
+                temp_size = 0;
+                multiplier = 1;
+            }
+        }
+        if (temp_size > 0)
+            result.digits[result.size++] = temp;
+
+        while (result.size > 0 && result.digits[result.size - 1] == 0)
+            result.size--;
+        if (result.size == 0)
+            result.isNegative = false;
+        return result;
+    }
+};
+
+// Value of a _big literal. The limbs for a given base are computed at compile
+// time the first time a BigInt of that base is built from it.
+template<FixedString Str>
+struct BigIntLiteral {
+    template<typename LimbT, auto Base>
+    static constexpr auto limbs = BigIntConstant<LimbT,
+            std::max<size_t>(1, (Str.length() + bigint_detail::block_size(Base) - 1) / bigint_detail::block_size(Base))>
+            ::template parse<Base>(Str);
+};
+
+template<FixedString Str>
+consteval BigIntLiteral<Str> operator""_big() {
+    (void) BigIntConstant<char, Str.length() + 1>::template parse<10>(Str);
+    return {};
+}
+
+// Layout of the binary limb format. Limbs follow the header directly, in
+// host byte order, least significant limb first.
+struct BigIntBinaryHeader {
+    static constexpr char MAGIC[4] = {'B', 'I', 'G', 'N'};
+    static constexpr uint16_t VERSION = 1;
+
+    char magic[4];
+    uint16_t version;
+    uint8_t isNegative;
+    uint8_t limb_width;
+    uint64_t base;
+    uint64_t limb_count;
+
+    void validate(size_t expected_limb_width) const {
+        if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+            throw std::invalid_argument("Not a BigInt binary stream");
+        if (version != VERSION)
+            throw std::invalid_argument("Unsupported BigInt binary version");
+        if (limb_width != expected_limb_width)
+            throw std::invalid_argument("Unsupported BigInt limb width");
+        if (!bigint_detail::is_power_of_ten(base) || base == 1)
+            throw std::invalid_argument("Unsupported BigInt base");
+    }
+
+    // Limbs come from untrusted bytes too; one at or above the base would
+    // break every later carry.
+    template<typename LimbT>
+    static void validate_limbs(const LimbT* limbs, size_t count, uint64_t base) {
+        for (size_t i = 0; i < count; ++i) {
+            if (limbs[i] >= base)
+                throw std::invalid_argument("BigInt limb out of range");
+        }
+    }
+};
+
+// Read-only BigInt over limbs owned by someone else, e.g. a mapped file.
+class BigIntView {
+private:
+    const unsigned long long* limbs = nullptr;
+    size_t limb_count = 0;
+    bool isNegative = false;
+    unsigned long long _base = 1000000;
+
+public:
+    BigIntView() = default;
+    BigIntView(const unsigned long long* data, size_t size, bool negative, unsigned long long base)
+            : limbs(data), limb_count(size), isNegative(negative), _base(base) {}
+
+    [[nodiscard]] size_t size() const { return limb_count; }
+    [[nodiscard]] bool negative() const { return isNegative; }
+    [[nodiscard]] unsigned long long base() const { return _base; }
+    [[nodiscard]] const unsigned long long* data() const { return limbs; }
+    unsigned long long operator[](size_t pos) const { return limbs[pos]; }
+
+    friend std::ostream& operator<<(std::ostream& os, const BigIntView& view) {
+        if (view.isNegative && view.limb_count > 0)
+            os << '-';
+        if (view.limb_count == 0)
+            return os << '0';
+        os << view.limbs[view.limb_count - 1];
+        for (size_t i = view.limb_count - 1; i-- > 0;)
+            os << std::setw(bigint_detail::block_size(view._base)) << std::setfill('0') << view.limbs[i];
+        return os;
+    }
+};
+
+template<typename Int>
+class BigIntAccumulator;
+
+template<typename LimbT, typename MulPolicy, typename DivPolicy, LimbT Base = 1000000>
+class BasicBigInt {
+    static_assert(std::is_unsigned_v<LimbT>, "Limbs must be unsigned");
+    static_assert(bigint_detail::is_power_of_ten(Base) && Base > 1 && Base <= 1000000000ULL,
+                  "Base must be a power of ten that keeps limb products in 64 bits");
+
+public:
+    using limb_type = LimbT;
+    using limbs_type = std::vector<LimbT, bigint_stats::allocator<LimbT>>;
+    using multiply_policy = MulPolicy;
+    using division_policy = DivPolicy;
+
+    static constexpr LimbT base = Base;
+    static constexpr int block_size = bigint_detail::block_size(Base);
+
+private:
+    // Copies share one limb buffer; it is only written while unshared.
+    std::shared_ptr<limbs_type> storage;
+    bool isNegative = false;
+    // Hash of the limbs alone, so it stays valid under negation and abs.
+    bigint_detail::HashCache limb_hash;
+
+    template<typename>
+    friend class BigIntAccumulator;
+
+    // Limbs for writing: a shared buffer is copied first.
+    limbs_type& mutable_limbs() {
+        limb_hash.set(0);
+        if (!storage) {
+            storage = std::make_shared<limbs_type>();
+        } else if (storage.use_count() > 1) {
+            storage = std::make_shared<limbs_type>(*storage);
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *storage;
+    }
+
+    // Reuses the limb buffer unless another BigInt shares it.
+    void parse_unsigned_value(bigint_detail::uint128_t value) {
+        if (storage && storage.use_count() > 1)
+            storage.reset();
+        limbs_type& digits = mutable_limbs();
+        digits.clear();
+        for (; value >> 64 != 0; value /= Base)
+            digits.push_back((LimbT) (value % Base));
+        for (auto low = (unsigned long long) value; low > 0; low /= Base)
+            digits.push_back(low % Base);
+    }
+
+    // this += (negative ? -magnitude : magnitude) in place.
+    void add_word(unsigned long long magnitude, bool negative) {
+        if (magnitude == 0)
+            return;
+        if (isNegative == negative || limbs().empty()) {
+            bigint_detail::add_word<Base>(mutable_limbs(), magnitude);
+            isNegative = negative;
+            return;
+        }
+        auto small = bigint_detail::to_uint128<Base>(limbs());
+        if (small && *small <= magnitude) {
+            parse_unsigned_value(magnitude - *small);
+            isNegative = negative;
+        } else {
+            bigint_detail::sub_word<Base>(mutable_limbs(), magnitude);
+        }
+        remove_leading_zeros();
+    }
+
+    void from_magnitude(bigint_detail::uint128_t magnitude, bool negative) {
+        parse_unsigned_value(magnitude);
+        isNegative = negative && magnitude != 0;
+    }
+
+    static bool fits_64(const limbs_type& digits) {
+        auto value = bigint_detail::to_uint128<Base>(digits);
+        return value && (*value >> 64) == 0;
+    }
+
+    // |this| if it is at most limit, with an exception otherwise.
+    [[nodiscard]] bigint_detail::uint128_t magnitude_up_to(bigint_detail::uint128_t limit) const {
+        auto value = bigint_detail::to_uint128<Base>(limbs());
+        if (!value || *value > limit)
+            throw std::out_of_range("BigInt does not fit in the target type");
+        return *value;
+    }
+
+    void remove_leading_zeros() {
+        if (!limbs().empty() && limbs().back() == 0)
+            bigint_detail::trim(mutable_limbs());
+        if (limbs().empty())
+            isNegative = false;
+    }
+
+    static std::strong_ordering compare_absolutes(const BasicBigInt& a, const BasicBigInt& b) {
+        return bigint_detail::compare(a.limbs(), b.limbs());
+    }
+
+    // |a| + |b| with the given sign, or |a| - |b| when the signs differ.
+    static BasicBigInt add_signed(const BasicBigInt& a, const BasicBigInt& b, bool b_negative) {
+        BasicBigInt result;
+        if (a.isNegative == b_negative) {
+            limbs_type& digits = result.mutable_limbs();
+            digits.reserve(std::max(a.limbs().size(), b.limbs().size()) + 1);
+            digits = a.limbs();
+            bigint_detail::add_shifted<Base>(digits, b.limbs(), 0);
+            result.isNegative = a.isNegative;
+        } else {
+            auto compare = compare_absolutes(a, b);
+            if (compare == std::strong_ordering::equal)
+                return result;
+            if (compare == std::strong_ordering::greater) {
+                limbs_type& digits = result.mutable_limbs() = a.limbs();
+                bigint_detail::sub_shifted<Base>(digits, b.limbs(), 0);
+                result.isNegative = a.isNegative;
+            } else {
+                limbs_type& digits = result.mutable_limbs() = b.limbs();
+                bigint_detail::sub_shifted<Base>(digits, a.limbs(), 0);
+                result.isNegative = b_negative;
+            }
+        }
+        result.remove_leading_zeros();
+        return result;
+    }
+
+    template<typename Policy>
+    void divide_with(const BasicBigInt& other, BasicBigInt& quotient, BasicBigInt& remainder) const {
+        if (other.limbs().empty())
+            throw std::invalid_argument("Division by zero");
+
+        Policy::template divide<Base>(limbs(), other.limbs(), quotient.mutable_limbs(), remainder.mutable_limbs());
+        quotient.isNegative = isNegative != other.isNegative;
+        quotient.remove_leading_zeros();
+        remainder.isNegative = isNegative;
+        remainder.remove_leading_zeros();
+    }
+
+    static std::ostream& write_decimal(std::ostream& os, const LimbT* limbs, size_t size, bool negative) {
+        if (negative && size > 0)
+            os << '-';
+        if (size == 0)
+            return os << '0';
+        os << limbs[size - 1];
+        for (size_t i = size - 1; i-- > 0;)
+            os << std::setw(block_size) << std::setfill('0') << limbs[i];
+        return os;
+    }
+
+public:
+    BasicBigInt() = default;
+
+    template<bigint_detail::word T>
+    explicit BasicBigInt(T value) {
+        from_magnitude(bigint_detail::word_magnitude(value), bigint_detail::is_negative(value));
+    }
+
+    explicit BasicBigInt(bigint_detail::int128_t value) {
+        auto magnitude = (bigint_detail::uint128_t) value;
+        from_magnitude(value < 0 ? 0 - magnitude : magnitude, value < 0);
+    }
+
+    explicit BasicBigInt(bigint_detail::uint128_t value) {
+        from_magnitude(value, false);
+    }
+
+    // Exact for every finite double; the fraction is truncated toward zero.
+    explicit BasicBigInt(double value) {
+        if (!std::isfinite(value))
+            throw std::invalid_argument("Value is not finite");
+        value = std::trunc(value);
+        if (value == 0)
+            return;
+        int exponent = 0;
+        double fraction = std::frexp(std::fabs(value), &exponent);
+        auto mantissa = (unsigned long long) std::ldexp(fraction, 53);
+        exponent -= 53;
+        if (exponent < 0) {
+            from_magnitude(mantissa >> -exponent, value < 0);
+            return;
+        }
+        from_magnitude(mantissa, value < 0);
+        for (; exponent > 0; exponent -= std::min(exponent, 32))
+            bigint_detail::multiply_word<Base>(mutable_limbs(), 1ULL << std::min(exponent, 32));
+    }
+
+    explicit BasicBigInt(const std::string& str) {
+        size_t index = 0;
+        if (!str.empty() && str[index] == '-') {
+            index++;
+            isNegative = true;
+        }
+        if (index == str.size())
+            throw std::invalid_argument("String contains no digits");
+
+        limbs_type& digits = mutable_limbs();
+        unsigned long long temp = 0;
+        unsigned long long multiplier = 1;
+        int temp_size = 0;
+        for (size_t end = str.length(); end > index; end--) {
+            if (!isdigit(str[end - 1]))
+                throw std::invalid_argument("String contains non-digit characters");
+            temp += (str[end - 1] - '0') * multiplier;
+            multiplier *= 10;
+            temp_size++;
+            if (temp_size == block_size) {
+                digits.push_back(temp);
+                temp = 0;
+                temp_size = 0;
+                multiplier = 1;
+            }
+        }
+        if (temp_size > 0)
+            digits.push_back(temp);
+        remove_leading_zeros();
+    }
+
+    template<FixedString Str>
+    BasicBigInt(BigIntLiteral<Str>) {
+        constexpr const auto& constant = BigIntLiteral<Str>::template limbs<LimbT, Base>;
+        mutable_limbs().assign(constant.digits.begin(), constant.digits.begin() + constant.size);
+        isNegative = constant.isNegative;
+    }
+
+    explicit BasicBigInt(const BigIntView& view) {
+        if (view.base() != Base)
+            throw std::invalid_argument("Unsupported BigInt base");
+        mutable_limbs().assign(view.data(), view.data() + view.size());
+        isNegative = view.negative();
+        remove_leading_zeros();
+    }
+
+    BasicBigInt(const BasicBigInt& other) = default;
+    BasicBigInt(BasicBigInt&& other) noexcept = default;
+
+    // Limbs [start, stop) of other, clamped to its length.
+    BasicBigInt(const BasicBigInt& other, long start, long stop) {
+        mutable_limbs() = bigint_detail::slice(other.limbs(), (size_t) start, (size_t) stop);
+        isNegative = other.isNegative;
+        remove_leading_zeros();
+    }
+
+    ~BasicBigInt() = default;
+
+    BasicBigInt& operator=(const BasicBigInt& other) = default;
+    BasicBigInt& operator=(BasicBigInt&& other) noexcept = default;
+
+    template<bigint_detail::word T>
+    BasicBigInt& operator=(T other) {
+        from_magnitude(bigint_detail::word_magnitude(other), bigint_detail::is_negative(other));
+        return *this;
+    }
+
+    template<typename Policy>
+    BasicBigInt multiply_with(const BasicBigInt& other) const {
+        BasicBigInt result;
+        Policy::template multiply<Base>(limbs(), other.limbs(), result.mutable_limbs());
+        result.isNegative = isNegative != other.isNegative;
+        result.remove_leading_zeros();
+        return result;
+    }
+
+    // Limbs for reading, least significant first.
+    [[nodiscard]] const limbs_type& limbs() const {
+        static const limbs_type empty;
+        return storage ? *storage : empty;
+    }
+
+    [[nodiscard]] size_t limb_count() const { return limbs().size(); }
+
+    // Adopts limbs given least significant first; every limb must be below
+    // Base, leading zeros are dropped.
+    static BasicBigInt from_limbs(limbs_type digits, bool negative = false) {
+        BasicBigInt result;
+        result.mutable_limbs() = std::move(digits);
+        result.isNegative = negative;
+        result.remove_leading_zeros();
+        return result;
+    }
+
+    // this * Base^limbs; a negative count drops the lowest limbs instead.
+    [[nodiscard]] BasicBigInt shifted(long limbs) const {
+        const limbs_type& digits = this->limbs();
+        BasicBigInt result;
+        result.isNegative = isNegative;
+        if (limbs >= 0) {
+            if (!digits.empty()) {
+                limbs_type& shifted_digits = result.mutable_limbs();
+                shifted_digits.assign((size_t) limbs, 0);
+                shifted_digits.insert(shifted_digits.end(), digits.begin(), digits.end());
+            }
+        } else if ((size_t) -limbs < digits.size()) {
+            result.mutable_limbs().assign(digits.begin() - limbs, digits.end());
+        }
+        result.remove_leading_zeros();
+        return result;
+    }
+
+    BasicBigInt schoolbook_multiply(const BasicBigInt& other) const {
+        return multiply_with<SchoolbookMultiply>(other);
+    }
+
+    BasicBigInt karatsuba_multiply(const BasicBigInt& other) const {
+        return multiply_with<KaratsubaMultiply>(other);
+    }
+
+    BasicBigInt fft_multiply(const BasicBigInt& other) const {
+        return multiply_with<FftMultiply>(other);
+    }
+
+    BasicBigInt operator+(const BasicBigInt& other) const {
+        return add_signed(*this, other, other.isNegative);
+    }
+
+    // Negation and abs share the limbs, so they cost O(1).
+    BasicBigInt operator-() const {
+        BasicBigInt a = *this;
+        a.isNegative = !a.isNegative && !limbs().empty();
+        return a;
+    }
+
+    [[nodiscard]] BasicBigInt abs() const {
+        BasicBigInt a = *this;
+        a.isNegative = false;
+        return a;
+    }
+
+    BasicBigInt operator-(const BasicBigInt& other) const {
+        return add_signed(*this, other, !other.isNegative);
+    }
+
+    BasicBigInt operator*(const BasicBigInt& other) const {
+        return multiply_with<MulPolicy>(other);
+    }
+
+    BasicBigInt operator/(const BasicBigInt& other) const {
+        BasicBigInt quotient, remainder;
+        divide_with<DivPolicy>(other, quotient, remainder);
+        return quotient;
+    }
+
+    // The remainder takes the sign of nothing: it is always in [0, |other|).
+    BasicBigInt operator%(const BasicBigInt& other) const {
+        BasicBigInt quotient, remainder;
+        divide_with<DivPolicy>(other, quotient, remainder);
+        if (remainder.isNegative) {
+            remainder.isNegative = false;
+            remainder = other.abs() - remainder;
+        }
+        return remainder;
+    }
+
+    BasicBigInt& operator+=(const BasicBigInt& other) { return *this = *this + other; }
+    BasicBigInt& operator-=(const BasicBigInt& other) { return *this = *this - other; }
+    BasicBigInt& operator*=(const BasicBigInt& other) { return *this = *this * other; }
+    BasicBigInt& operator/=(const BasicBigInt& other) { return *this = *this / other; }
+
+    BasicBigInt operator++() { return *this += 1; }
+    BasicBigInt operator--() { return *this -= 1; }
+
+    // Mixed arithmetic with machine integers runs single-word kernels on the
+    // limbs in place, so the compound forms do not allocate unless the
+    // number grows or its limbs are shared.
+    template<bigint_detail::word T>
+    BasicBigInt& operator+=(T value) {
+        add_word(bigint_detail::word_magnitude(value), bigint_detail::is_negative(value));
+        return *this;
+    }
+
+    template<bigint_detail::word T>
+    BasicBigInt& operator-=(T value) {
+        add_word(bigint_detail::word_magnitude(value), !(bigint_detail::is_negative(value)));
+        return *this;
+    }
+
+    template<bigint_detail::word T>
+    BasicBigInt& operator*=(T value) {
+        if (limbs().empty())
+            return *this;
+        bigint_detail::multiply_word<Base>(mutable_limbs(), bigint_detail::word_magnitude(value));
+        isNegative = isNegative != (bigint_detail::is_negative(value));
+        remove_leading_zeros();
+        return *this;
+    }
+
+    // Truncates toward zero, like division by a BigInt.
+    template<bigint_detail::word T>
+    BasicBigInt& operator/=(T value) {
+        if (value == 0)
+            throw std::invalid_argument("Division by zero");
+        if (limbs().empty())
+            return *this;
+        bigint_detail::divide_word<Base>(mutable_limbs(), bigint_detail::word_magnitude(value));
+        isNegative = isNegative != (bigint_detail::is_negative(value));
+        remove_leading_zeros();
+        return *this;
+    }
+
+    template<bigint_detail::word T>
+    BasicBigInt operator+(T value) const { return BasicBigInt(*this) += value; }
+
+    template<bigint_detail::word T>
+    BasicBigInt operator-(T value) const { return BasicBigInt(*this) -= value; }
+
+    template<bigint_detail::word T>
+    BasicBigInt operator*(T value) const { return BasicBigInt(*this) *= value; }
+
+    template<bigint_detail::word T>
+    BasicBigInt operator/(T value) const { return BasicBigInt(*this) /= value; }
+
+    // In [0, |value|) like the BigInt remainder, returned as a machine word.
+    template<bigint_detail::word T>
+    unsigned long long operator%(T value) const {
+        if (value == 0)
+            throw std::invalid_argument("Division by zero");
+        unsigned long long modulus = bigint_detail::word_magnitude(value);
+        unsigned long long remainder = bigint_detail::modulo_word<Base>(limbs(), modulus);
+        return isNegative && remainder != 0 ? modulus - remainder : remainder;
+    }
+
+    template<bigint_detail::word T>
+    friend BasicBigInt operator+(T value, const BasicBigInt& num) { return num + value; }
+
+    template<bigint_detail::word T>
+    friend BasicBigInt operator-(T value, const BasicBigInt& num) { return -(num - value); }
+
+    template<bigint_detail::word T>
+    friend BasicBigInt operator*(T value, const BasicBigInt& num) { return num * value; }
+
+    template<bigint_detail::word T>
+    bool operator==(T value) const {
+        return (*this <=> value) == 0;
+    }
+
+    template<bigint_detail::word T>
+    std::strong_ordering operator<=>(T value) const {
+        bool negative = bigint_detail::is_negative(value);
+        if (isNegative != negative)
+            return isNegative ? std::strong_ordering::less : std::strong_ordering::greater;
+        auto magnitude = bigint_detail::to_uint128<Base>(limbs());
+        auto comparison = magnitude ? *magnitude <=> bigint_detail::word_magnitude(value)
+                                    : std::strong_ordering::greater;
+        return negative ? 0 <=> comparison : comparison;
+    }
+
+    // Exact conversions; values outside the target range throw
+    // std::out_of_range.
+    template<bigint_detail::word T>
+    explicit operator T() const {
+        using U = std::make_unsigned_t<T>;
+        if (std::is_unsigned_v<T> && isNegative)
+            throw std::out_of_range("BigInt does not fit in the target type");
+        auto max = (bigint_detail::uint128_t) std::numeric_limits<T>::max();
+        auto magnitude = magnitude_up_to(isNegative ? max + std::is_signed_v<T> : max);
+        return isNegative ? (T) (U) (0 - (U) magnitude) : (T) magnitude;
+    }
+
+    explicit operator bigint_detail::int128_t() const {
+        auto max = ~(bigint_detail::uint128_t) 0 >> 1;
+        auto magnitude = magnitude_up_to(isNegative ? max + 1 : max);
+        return (bigint_detail::int128_t) (isNegative ? 0 - magnitude : magnitude);
+    }
+
+    explicit operator bigint_detail::uint128_t() const {
+        if (isNegative)
+            throw std::out_of_range("BigInt does not fit in the target type");
+        return magnitude_up_to(~(bigint_detail::uint128_t) 0);
+    }
+
+    // Correctly rounded to nearest, ties to even; too large values give
+    // infinity. The magnitude is halved down to 64 bits with the lost bits
+    // folded into the lowest one, so the hardware conversion rounds once.
+    explicit operator double() const {
+        const limbs_type& digits = limbs();
+        if (digits.size() * block_size > 400)
+            return isNegative ? -HUGE_VAL : HUGE_VAL;
+
+        limbs_type magnitude = digits;
+        int shift = 0;
+        bool sticky = false;
+        const double limb_bits = std::log2((double) Base);
+        while (!fits_64(magnitude)) {
+            int bits = (int) ((double) (magnitude.size() - 1) * limb_bits) + std::bit_width((unsigned long long) magnitude.back());
+            int step = std::clamp(bits - 64, 1, 32);
+            sticky |= bigint_detail::divide_word<Base>(magnitude, 1ULL << step) != 0;
+            shift += step;
+        }
+        auto value = (unsigned long long) *bigint_detail::to_uint128<Base>(magnitude);
+        double result = std::ldexp((double) (value | sticky), shift);
+        return isNegative ? -result : result;
+    }
+
+    // Computed on first use and cached; copies share it with the limbs.
+    [[nodiscard]] size_t hash() const {
+        size_t h = limb_hash.get();
+        if (h == 0) {
+            h = bigint_detail::hash_limbs(limbs());
+            limb_hash.set(h);
+        }
+        return isNegative ? ~h : h;
+    }
+
+    // Shared limbs are equal without a look at them, and hashes that are
+    // already known can tell different values apart.
+    bool operator==(const BasicBigInt& other) const {
+        if (isNegative != other.isNegative)
+            return false;
+        if (storage == other.storage)
+            return true;
+        size_t h = limb_hash.get(), other_h = other.limb_hash.get();
+        if (h != 0 && other_h != 0 && h != other_h)
+            return false;
+        return limbs() == other.limbs();
+    }
+
+    std::strong_ordering operator<=>(const BasicBigInt& other) const {
+        if (isNegative != other.isNegative) {
+            return isNegative ? std::strong_ordering::less
+                              : std::strong_ordering::greater;
+        }
+        if (storage == other.storage)
+            return std::strong_ordering::equal;
+        const auto abs_comparison = compare_absolutes(*this, other);
+        if (isNegative)
+            return 0 <=> abs_comparison;
+        return abs_comparison;
+    }
+
+    // Reads the token straight from the stream buffer and packs each digit
+    // into the current limb as it arrives, so no copy of the text is kept. Limbs are filled from the most significant end; once the length is
+    // known the whole number is shifted right by the missing digits of the
+    // last limb with one linear pass.
+    friend std::istream& operator>>(std::istream& is, BasicBigInt& num) {
+        std::istream::sentry sentry(is);
+        if (!sentry)
+            return is;
+
+        std::streambuf* buf = is.rdbuf();
+        BasicBigInt result;
+        limbs_type& digits = result.mutable_limbs();
+
+        int c = buf->sgetc();
+        if (c == '-') {
+            result.isNegative = true;
+            c = buf->snextc();
+        }
+
+        unsigned long long limb = 0;
+        int limb_size = 0;
+        size_t total = 0;
+        while (c != std::char_traits<char>::eof() && !isspace(c)) {
+            if (!isdigit(c))
+                throw std::invalid_argument("String contains non-digit characters");
+            limb = limb * 10 + (c - '0');
+            if (++limb_size == block_size) {
+                digits.push_back(limb);
+                limb = 0;
+                limb_size = 0;
+            }
+            total++;
+            c = buf->snextc();
+        }
+
+        if (c == std::char_traits<char>::eof())
+            is.setstate(std::ios::eofbit);
+        if (total == 0) {
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+
+        unsigned long long shift = 1;
+        if (limb_size > 0) {
+            for (int i = limb_size; i < block_size; ++i) {
+                limb *= 10;
+                shift *= 10;
+            }
+            digits.push_back(limb);
+        }
+        std::reverse(digits.begin(), digits.end());
+
+        if (shift > 1) {
+            unsigned long long remainder = 0;
+            for (LimbT& digit : std::ranges::reverse_view(digits)) {
+                unsigned long long current = remainder * Base + digit;
+                digit = current / shift;
+                remainder = current % shift;
+            }
+        }
+
+        result.remove_leading_zeros();
+        num = std::move(result);
+        return is;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const BasicBigInt& num) {
+        return write_decimal(os, num.limbs().data(), num.limbs().size(), num.isNegative);
+    }
+
+    void write_binary(std::ostream& os) const {
+        BigIntBinaryHeader header {};
+        std::memcpy(header.magic, BigIntBinaryHeader::MAGIC, sizeof(header.magic));
+        header.version = BigIntBinaryHeader::VERSION;
+        header.isNegative = isNegative;
+        header.limb_width = sizeof(LimbT);
+        header.base = Base;
+        header.limb_count = limbs().size();
+
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        os.write(reinterpret_cast<const char*>(limbs().data()), (std::streamsize) (limbs().size() * sizeof(LimbT)));
+    }
+
+    static BasicBigInt read_binary(std::istream& is) {
+        BigIntBinaryHeader header {};
+        if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            throw std::invalid_argument("Truncated BigInt binary stream");
+        header.validate(sizeof(LimbT));
+        if (header.base != Base)
+            throw std::invalid_argument("Unsupported BigInt base");
+
+        BasicBigInt result;
+        limbs_type& digits = result.mutable_limbs();
+        if (header.limb_count > std::min<uint64_t>(digits.max_size(), PTRDIFF_MAX / sizeof(LimbT)))
+            throw std::invalid_argument("BigInt binary stream is too long");
+        // Read in bounded chunks, so a corrupt count runs into the end of a
+        // short stream before anything near its size is allocated.
+        constexpr size_t chunk = size_t(1) << 16;
+        auto count = (size_t) header.limb_count;
+        for (size_t done = 0; done < count;) {
+            size_t n = std::min(chunk, count - done);
+            digits.resize(done + n);
+            if (!is.read(reinterpret_cast<char*>(digits.data() + done), (std::streamsize) (n * sizeof(LimbT))))
+                throw std::invalid_argument("Truncated BigInt binary stream");
+            done += n;
+        }
+        BigIntBinaryHeader::validate_limbs(digits.data(), count, Base);
+        result.isNegative = header.isNegative;
+        result.remove_leading_zeros();
+        return result;
+    }
+};
+
+template<typename LimbT, typename MulPolicy, typename DivPolicy, LimbT Base>
+struct std::hash<BasicBigInt<LimbT, MulPolicy, DivPolicy, Base>> {
+    size_t operator()(const BasicBigInt<LimbT, MulPolicy, DivPolicy, Base>& value) const noexcept {
+        return value.hash();
+    }
+};
+
+template<typename LimbT, typename MulPolicy, typename DivPolicy, LimbT Base>
+BasicBigInt<LimbT, MulPolicy, DivPolicy, Base> mod_exp(const BasicBigInt<LimbT, MulPolicy, DivPolicy, Base>& base,
+                                                       const BasicBigInt<LimbT, MulPolicy, DivPolicy, Base>& exp,
+                                                       const BasicBigInt<LimbT, MulPolicy, DivPolicy, Base>& mod) {
+    using Int = BasicBigInt<LimbT, MulPolicy, DivPolicy, Base>;
+    Int result(1);
+    Int a = base % mod;
+    Int b = exp;
+
+    while (b > 0) {
+        if (b % 2 == 1) {
+            result = (result * a) % mod;
+        }
+        a = (a * a) % mod;
+
+        b /= 2;
+    }
+
+    return result % mod;
+}
+
+// floor(sqrt(n)). The square root of the leading half of the limbs, rounded
+// up, is already correct to about half the digits, so Newton's iteration from
+// above finishes after one or two divisions at every level.
+template<typename LimbT, typename MulPolicy, typename DivPolicy, LimbT Base>
+BasicBigInt<LimbT, MulPolicy, DivPolicy, Base> isqrt(const BasicBigInt<LimbT, MulPolicy, DivPolicy, Base>& n) {
+    using Int = BasicBigInt<LimbT, MulPolicy, DivPolicy, Base>;
+    if (n < 0)
+        throw std::invalid_argument("Square root of a negative number");
+    if (n == 0)
+        return n;
+
+    Int x;
+    if (n.limb_count() <= 2) {
+        auto value = (unsigned long long) n;
+        x = Int((unsigned long long) std::sqrt((long double) value) + 1);
+    } else {
+        long k = std::max<long>(1, (long) n.limb_count() / 4);
+        x = (isqrt(n.shifted(-2 * k)) + 1).shifted(k);
+    }
+
+    while (true) {
+        Int next = (x + n / x) / 2;
+        if (next >= x)
+            return x;
+        x = std::move(next);
+    }
+}
+
+// Maps a file written by write_binary and exposes its limbs in place.
+class MappedBigInt {
+private:
+    void* mapping = MAP_FAILED;
+    size_t mapping_size = 0;
+    BigIntView _view;
+
+    void unmap() {
+        if (mapping != MAP_FAILED)
+            munmap(mapping, mapping_size);
+        mapping = MAP_FAILED;
+        mapping_size = 0;
+        _view = BigIntView();
+    }
+
+public:
+    explicit MappedBigInt(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open " + path);
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(BigIntBinaryHeader)) {
+            close(fd);
+            throw std::invalid_argument("Truncated BigInt binary file " + path);
+        }
+        mapping_size = st.st_size;
+        mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("Cannot map " + path);
+
+        const auto* header = static_cast<const BigIntBinaryHeader*>(mapping);
+        try {
+            header->validate(sizeof(unsigned long long));
+            if (header->limb_count > (mapping_size - sizeof(BigIntBinaryHeader)) / sizeof(unsigned long long))
+                throw std::invalid_argument("Truncated BigInt binary file " + path);
+            BigIntBinaryHeader::validate_limbs(reinterpret_cast<const unsigned long long*>(header + 1),
+                                               header->limb_count, header->base);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+
+        size_t size = header->limb_count;
+        const auto* limbs = reinterpret_cast<const unsigned long long*>(header + 1);
+        while (size > 0 && limbs[size - 1] == 0)
+            size--;
+        _view = BigIntView(limbs, size, size > 0 && header->isNegative, header->base);
+    }
+
+    MappedBigInt(const MappedBigInt&) = delete;
+    MappedBigInt& operator=(const MappedBigInt&) = delete;
+
+    MappedBigInt(MappedBigInt&& other) noexcept
+            : mapping(other.mapping), mapping_size(other.mapping_size), _view(other._view) {
+        other.mapping = MAP_FAILED;
+        other.mapping_size = 0;
+        other._view = BigIntView();
+    }
+
+    MappedBigInt& operator=(MappedBigInt&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            std::swap(mapping, other.mapping);
+            std::swap(mapping_size, other.mapping_size);
+            std::swap(_view, other._view);
+        }
+        return *this;
+    }
+
+    ~MappedBigInt() { unmap(); }
+
+    [[nodiscard]] const BigIntView& view() const { return _view; }
+};
+
+template<typename Int>
+void save_binary(const Int& value, const std::string& path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Cannot open " + path);
+    value.write_binary(file);
+    if (!file)
+        throw std::runtime_error("Cannot write " + path);
+}
+
+template<typename Int>
+Int load_binary(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open " + path);
+    return Int::read_binary(file);
+}
+
+#endif //FUNDAMENTAL_ALGORITHMS_2_BASIC_BIGINT_H
@@ -0,0 +1,72 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_BATCH_MOD_EXP_H
+#define FUNDAMENTAL_ALGORITHMS_2_BATCH_MOD_EXP_H
+
+#include "modint.h"
+#include "thread_pool.h"
+#include <chrono>
+#include <map>
+#include <span>
+
+template<typename Int>
+struct ModExpJob {
+    Int base;
+    Int exponent;
+    Int modulus;
+};
+
+// Seconds per job within one batch, and the wall time of the whole batch.
+struct BatchLatency {
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+    double total = 0;
+};
+
+// base^exponent mod modulus for every job, in input order. Jobs with equal
+// moduli share one ModContext, and the jobs run as tasks on the pool.
+// Negative exponents go through the modular inverse.
+template<typename Int>
+std::vector<Int> batch_mod_exp(std::span<const ModExpJob<Int>> jobs, BatchLatency* latency = nullptr,
+                               ThreadPool& pool = ThreadPool::shared()) {
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+
+    std::map<Int, std::shared_ptr<const ModContext<Int>>> contexts;
+    for (const auto& job : jobs) {
+        if (job.modulus <= Int(0))
+            throw std::invalid_argument("Modulus must be positive");
+        if (job.modulus != Int(1) && !contexts.contains(job.modulus))
+            contexts.emplace(job.modulus, make_mod_context(job.modulus));
+    }
+
+    std::vector<Int> results(jobs.size());
+    std::vector<double> seconds(jobs.size());
+    std::vector<ThreadPool::Handle> handles;
+    handles.reserve(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        handles.push_back(pool.submit([&, i] {
+            auto job_start = clock::now();
+            const ModExpJob<Int>& job = jobs[i];
+            if (job.modulus != Int(1))
+                results[i] = ModInt<Int>(contexts.at(job.modulus), job.base).pow(job.exponent).value();
+            seconds[i] = std::chrono::duration<double>(clock::now() - job_start).count();
+        }));
+    }
+    ThreadPool::wait_all(handles);
+
+    if (latency) {
+        std::sort(seconds.begin(), seconds.end());
+        auto percentile = [&](double p) {
+            return seconds.empty() ? 0.0 : seconds[(size_t) (p * (double) (seconds.size() - 1))];
+        };
+        latency->p50 = percentile(0.5);
+        latency->p90 = percentile(0.9);
+        latency->p99 = percentile(0.99);
+        latency->max = percentile(1.0);
+        latency->total = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return results;
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_BIGFLOAT_H
+#define FUNDAMENTAL_ALGORITHMS_2_BIGFLOAT_H
+
+#include "basic_bigint.h"
+#include <string>
+
+// mantissa * 10^exponent with the mantissa rounded to at most precision
+// significant decimal digits, half to even. Every operation is computed as
+// if exactly and rounded once to the larger precision of its operands.
+// Division and sqrt go through Int's division policy and isqrt, so with
+// NewtonDivision they are Newton iterations on Int's multiplier.
+template<typename Int>
+class BigFloat {
+    static constexpr int block = Int::block_size;
+
+    Int mantissa_;
+    long exponent_ = 0;
+    size_t precision_;
+
+    static Int power_of_ten(size_t n) {
+        long long small = 1;
+        for (size_t i = 0; i < n % block; ++i)
+            small *= 10;
+        return Int(small).shifted((long) (n / block));
+    }
+
+    static size_t digits(const Int& x) {
+        const auto& limbs = x.limbs();
+        if (limbs.empty())
+            return 0;
+        size_t count = (limbs.size() - 1) * block;
+        for (auto top = limbs.back(); top > 0; top /= 10)
+            count++;
+        return count;
+    }
+
+    static size_t trailing_zeros(const Int& x) {
+        const auto& limbs = x.limbs();
+        size_t count = 0, i = 0;
+        for (; i < limbs.size() && limbs[i] == 0; ++i)
+            count += block;
+        if (i < limbs.size()) {
+            for (auto limb = limbs[i]; limb % 10 == 0; limb /= 10)
+                count++;
+        }
+        return count;
+    }
+
+    // Rounds mantissa * 10^exponent to precision digits. sticky says that
+    // the exact value is a little further from zero than that.
+    BigFloat(Int mantissa, long exponent, size_t precision, bool sticky)
+            : exponent_(exponent), precision_(precision) {
+        bool negative = mantissa < Int(0);
+        Int magnitude = mantissa.abs();
+        size_t count = digits(magnitude);
+        if (count > precision) {
+            size_t drop = count - precision;
+            Int unit = power_of_ten(drop);
+            Int kept = magnitude / unit;
+            Int twice_rest = (magnitude - kept * unit) * Int(2);
+            auto half = twice_rest <=> unit;
+            bool odd = !kept.limbs().empty() && kept.limbs()[0] % 2 == 1;
+            if (half > 0 || (half == 0 && (sticky || odd)))
+                kept += Int(1);
+            magnitude = std::move(kept);
+            exponent_ += (long) drop;
+        }
+
+        size_t zeros = trailing_zeros(magnitude);
+        if (zeros > 0) {
+            magnitude = magnitude.shifted(-(long) (zeros / block)) / power_of_ten(zeros % block);
+            exponent_ += (long) zeros;
+        }
+        if (magnitude.limbs().empty())
+            exponent_ = 0;
+        mantissa_ = negative ? -magnitude : magnitude;
+    }
+
+    // Position of the leading digit, 10^position <= |value|.
+    [[nodiscard]] long top() const { return exponent_ + (long) digits(mantissa_) - 1; }
+
+    // a + b with b's exponent not above a's.
+    static BigFloat add_aligned(const BigFloat& a, const BigFloat& b, size_t precision) {
+        Int sum = a.mantissa_ * power_of_ten((size_t) (a.exponent_ - b.exponent_)) + b.mantissa_;
+        return BigFloat(std::move(sum), b.exponent_, precision, false);
+    }
+
+public:
+    static constexpr size_t default_precision = 50;
+
+    explicit BigFloat(size_t precision = default_precision) : precision_(std::max<size_t>(precision, 1)) {}
+
+    explicit BigFloat(const Int& value, size_t precision = default_precision)
+            : BigFloat(value, 0, std::max<size_t>(precision, 1), false) {}
+
+    BigFloat(const Int& mantissa, long exponent, size_t precision = default_precision)
+            : BigFloat(mantissa, exponent, std::max<size_t>(precision, 1), false) {}
+
+    // [-]digits[.digits][e[+|-]digits]
+    explicit BigFloat(const std::string& str, size_t precision = default_precision)
+            : precision_(std::max<size_t>(precision, 1)) {
+        size_t e = str.find_first_of("eE");
+        std::string digits_part = str.substr(0, e);
+        long exponent = 0;
+        if (e != std::string::npos) {
+            std::string exponent_part = str.substr(e + 1);
+            size_t used = 0;
+            try {
+                exponent = std::stol(exponent_part, &used);
+            } catch (const std::logic_error&) {
+                used = std::string::npos;
+            }
+            if (used != exponent_part.size())
+                throw std::invalid_argument("Malformed exponent");
+        }
+        size_t point = digits_part.find('.');
+        if (point != std::string::npos) {
+            exponent -= (long) (digits_part.size() - point - 1);
+            digits_part.erase(point, 1);
+        }
+        *this = BigFloat(Int(digits_part), exponent, precision_, false);
+    }
+
+    [[nodiscard]] const Int& mantissa() const { return mantissa_; }
+    [[nodiscard]] long exponent() const { return exponent_; }
+    [[nodiscard]] size_t precision() const { return precision_; }
+    [[nodiscard]] bool is_zero() const { return mantissa_.limbs().empty(); }
+
+    [[nodiscard]] BigFloat with_precision(size_t precision) const {
+        return BigFloat(mantissa_, exponent_, std::max<size_t>(precision, 1), false);
+    }
+
+    // Rounded to a multiple of 10^-decimals, half to even, for fixed-point
+    // amounts. The precision grows if the integer part needs it.
+    [[nodiscard]] BigFloat quantize(size_t decimals) const {
+        if (is_zero() || exponent_ >= -(long) decimals)
+            return *this;
+        long keep = top() + (long) decimals + 1;
+        if (keep <= 0) {
+            // Below half of the last place unless exactly at or above it.
+            BigFloat half(Int(5), -(long) decimals - 1, 1);
+            bool up = keep == 0 && abs() > half;
+            BigFloat result(precision_);
+            if (up)
+                result = BigFloat(Int(mantissa_ < Int(0) ? -1 : 1), -(long) decimals, precision_);
+            return result;
+        }
+        BigFloat rounded(mantissa_, exponent_, (size_t) keep, false);
+        rounded.precision_ = std::max(precision_, (size_t) keep);
+        return rounded;
+    }
+
+    [[nodiscard]] BigFloat abs() const {
+        BigFloat result = *this;
+        result.mantissa_ = mantissa_.abs();
+        return result;
+    }
+
+    BigFloat operator-() const {
+        BigFloat result = *this;
+        result.mantissa_ = -mantissa_;
+        return result;
+    }
+
+    BigFloat operator+(const BigFloat& other) const {
+        size_t precision = std::max(precision_, other.precision_);
+        if (is_zero())
+            return other.with_precision(precision);
+        if (other.is_zero())
+            return with_precision(precision);
+
+        const BigFloat& high = top() >= other.top() ? *this : other;
+        const BigFloat& low = top() >= other.top() ? other : *this;
+        // A term entirely below the last place of the result only decides
+        // the rounding, so a single digit far enough down stands in for it.
+        long limit = high.top() - (long) precision - 2;
+        if (low.top() < limit) {
+            BigFloat stand_in = low;
+            stand_in.mantissa_ = Int(low.mantissa_ < Int(0) ? -1 : 1);
+            stand_in.exponent_ = limit - 1;
+            return add_aligned(high, stand_in, precision);
+        }
+        return high.exponent_ >= low.exponent_ ? add_aligned(high, low, precision)
+                                                : add_aligned(low, high, precision);
+    }
+
+    BigFloat operator-(const BigFloat& other) const {
+        return *this + -other;
+    }
+
+    BigFloat operator*(const BigFloat& other) const {
+        return BigFloat(mantissa_ * other.mantissa_, exponent_ + other.exponent_,
+                        std::max(precision_, other.precision_), false);
+    }
+
+    BigFloat operator/(const BigFloat& other) const {
+        if (other.is_zero())
+            throw std::invalid_argument("Division by zero");
+        size_t precision = std::max(precision_, other.precision_);
+        if (is_zero())
+            return BigFloat(precision);
+
+        // Scaled so that the quotient has two digits beyond the precision,
+        // and the remainder only decides ties.
+        long scale = std::max<long>(0, (long) precision + 2 + (long) digits(other.mantissa_) -
+                                       (long) digits(mantissa_));
+        Int dividend = mantissa_.abs() * power_of_ten((size_t) scale);
+        Int divisor = other.mantissa_.abs();
+        Int quotient = dividend / divisor;
+        bool sticky = quotient * divisor != dividend;
+        bool negative = (mantissa_ < Int(0)) != (other.mantissa_ < Int(0));
+        return BigFloat(negative ? -quotient : quotient, exponent_ - other.exponent_ - scale, precision, sticky);
+    }
+
+    BigFloat& operator+=(const BigFloat& other) { return *this = *this + other; }
+    BigFloat& operator-=(const BigFloat& other) { return *this = *this - other; }
+    BigFloat& operator*=(const BigFloat& other) { return *this = *this * other; }
+    BigFloat& operator/=(const BigFloat& other) { return *this = *this / other; }
+
+    // Values compare exactly, whatever their precisions.
+    bool operator==(const BigFloat& other) const {
+        return mantissa_ == other.mantissa_ && exponent_ == other.exponent_;
+    }
+
+    std::strong_ordering operator<=>(const BigFloat& other) const {
+        BigFloat difference = *this - other;
+        return difference.mantissa_ <=> Int(0);
+    }
+
+    // Plain positional notation while the exponent stays within a few
+    // precisions of the point, scientific notation beyond that.
+    friend std::ostream& operator<<(std::ostream& os, const BigFloat& value) {
+        std::stringstream ss;
+        ss << value.mantissa_.abs();
+        std::string digits = ss.str();
+        if (value.mantissa_ < Int(0))
+            os << '-';
+
+        long span = 2 * (long) std::max(value.precision_, digits.size()) + 10;
+        if (value.exponent_ >= 0 && value.exponent_ <= span)
+            return os << digits << std::string((size_t) value.exponent_, '0');
+        if (value.exponent_ < 0 && -value.exponent_ <= span) {
+            auto fraction = (size_t) -value.exponent_;
+            if (digits.size() <= fraction)
+                digits.insert(0, fraction - digits.size() + 1, '0');
+            digits.insert(digits.size() - fraction, 1, '.');
+            return os << digits;
+        }
+        os << digits[0];
+        if (digits.size() > 1)
+            os << '.' << digits.substr(1);
+        return os << 'e' << value.top();
+    }
+
+    template<typename I>
+    friend BigFloat<I> sqrt(const BigFloat<I>& x);
+};
+
+// Correctly rounded square root through isqrt on a scaled mantissa.
+template<typename Int>
+BigFloat<Int> sqrt(const BigFloat<Int>& x) {
+    using Float = BigFloat<Int>;
+    if (x.mantissa_ < Int(0))
+        throw std::invalid_argument("Square root of a negative number");
+    if (x.is_zero())
+        return Float(x.precision_);
+
+    // Enough digits for two beyond the precision, with an even exponent left.
+    long scale = std::max<long>(0, 2 * (long) x.precision_ + 4 - (long) Float::digits(x.mantissa_));
+    if ((x.exponent_ - scale) % 2 != 0)
+        scale++;
+    Int radicand = x.mantissa_ * Float::power_of_ten((size_t) scale);
+    Int root = isqrt(radicand);
+    bool sticky = root * root != radicand;
+    return Float(std::move(root), (x.exponent_ - scale) / 2, x.precision_, sticky);
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_BIGINT_THRESHOLDS_H
+#define FUNDAMENTAL_ALGORITHMS_2_BIGINT_THRESHOLDS_H
+
+// Crossovers used by DispatchMultiply and DispatchDivision, in limbs of the
+// shorter factor or of the divisor. The tune_bigint_thresholds target
+// measures them on the build host and writes bigint_thresholds.generated.h
+// next to this header; without it, or with BIGINT_DEFAULT_THRESHOLDS, the
+// defaults below apply.
+#if !defined(BIGINT_DEFAULT_THRESHOLDS) && __has_include("bigint_thresholds.generated.h")
+#include "bigint_thresholds.generated.h"
+#endif
+
+#ifndef BIGINT_KARATSUBA_FROM
+#define BIGINT_KARATSUBA_FROM 32
+#endif
+
+#ifndef BIGINT_FFT_FROM
+#define BIGINT_FFT_FROM 1024
+#endif
+
+// Also where the long double FFT stops being safely exact for base 10^6.
+#ifndef BIGINT_SSA_FROM
+#define BIGINT_SSA_FROM 262144
+#endif
+
+#ifndef BIGINT_NEWTON_FROM
+#define BIGINT_NEWTON_FROM 32
+#endif
+
+#endif
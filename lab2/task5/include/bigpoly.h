@@ -0,0 +1,170 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_BIGPOLY_H
+#define FUNDAMENTAL_ALGORITHMS_2_BIGPOLY_H
+
+#include "basic_bigint.h"
+#include <initializer_list>
+
+// Dense polynomial with BigInt coefficients, lowest degree first and without
+// trailing zero coefficients. Products use Kronecker substitution: both
+// factors are evaluated at a large power of the base, multiplied with one
+// call to Int's multiplication policy, and the coefficients are read back
+// from the limbs, so the cost follows the BigInt multiplier instead of
+// being quadratic in the degree.
+template<typename Int>
+class BigPoly {
+    using Limbs = typename Int::limbs_type;
+
+    std::vector<Int> coeffs;
+
+    void trim() {
+        while (!coeffs.empty() && coeffs.back() == 0)
+            coeffs.pop_back();
+    }
+
+    [[nodiscard]] size_t max_limbs() const {
+        size_t width = 0;
+        for (const Int& c : coeffs)
+            width = std::max(width, c.limb_count());
+        return width;
+    }
+
+    // Value at Base^width as one BigInt: positive and negative coefficients
+    // are laid out side by side in two limb buffers and subtracted once.
+    [[nodiscard]] Int pack(size_t width) const {
+        Limbs positive(coeffs.size() * width, 0), negative(coeffs.size() * width, 0);
+        for (size_t i = 0; i < coeffs.size(); ++i) {
+            Limbs& target = coeffs[i] < 0 ? negative : positive;
+            std::copy(coeffs[i].limbs().begin(), coeffs[i].limbs().end(), target.begin() + (long) (i * width));
+        }
+        return Int::from_limbs(std::move(positive)) - Int::from_limbs(std::move(negative));
+    }
+
+    // Inverse of pack for coefficients in (-Base^width / 2, Base^width / 2):
+    // a slot at or above half of Base^width stands for a negative
+    // coefficient and borrows one from the slot above.
+    static BigPoly unpack(const Int& value, size_t width, size_t count) {
+        const Limbs& limbs = value.limbs();
+        Int slot_base = Int(1).shifted((long) width);
+        BigPoly result;
+        result.coeffs.reserve(count);
+        bool carry = false;
+        for (size_t i = 0; i < count; ++i) {
+            size_t start = std::min(i * width, limbs.size()), stop = std::min(start + width, limbs.size());
+            Int slot = Int::from_limbs(Limbs(limbs.begin() + (long) start, limbs.begin() + (long) stop));
+            if (carry)
+                slot += 1;
+            // A full slot plus the borrow is zero with a borrow again.
+            bool overflow = slot.limb_count() > width;
+            bool negative = slot.limb_count() == width && slot.limbs().back() >= Int::base / 2;
+            if (overflow)
+                slot = Int(0);
+            result.coeffs.push_back(negative ? slot - slot_base : slot);
+            carry = negative || overflow;
+        }
+        if (value < 0) {
+            for (Int& c : result.coeffs)
+                c = -c;
+        }
+        result.trim();
+        return result;
+    }
+
+public:
+    BigPoly() = default;
+
+    explicit BigPoly(std::vector<Int> coefficients) : coeffs(std::move(coefficients)) {
+        trim();
+    }
+
+    BigPoly(std::initializer_list<Int> coefficients) : coeffs(coefficients) {
+        trim();
+    }
+
+    [[nodiscard]] const std::vector<Int>& coefficients() const { return coeffs; }
+
+    // -1 for the zero polynomial.
+    [[nodiscard]] long degree() const { return (long) coeffs.size() - 1; }
+
+    // Coefficient of x^i, zero past the degree.
+    [[nodiscard]] Int operator[](size_t i) const {
+        return i < coeffs.size() ? coeffs[i] : Int(0);
+    }
+
+    BigPoly operator+(const BigPoly& other) const {
+        BigPoly result = coeffs.size() >= other.coeffs.size() ? *this : other;
+        const BigPoly& shorter = coeffs.size() >= other.coeffs.size() ? other : *this;
+        for (size_t i = 0; i < shorter.coeffs.size(); ++i)
+            result.coeffs[i] += shorter.coeffs[i];
+        result.trim();
+        return result;
+    }
+
+    BigPoly operator-() const {
+        BigPoly result = *this;
+        for (Int& c : result.coeffs)
+            c = -c;
+        return result;
+    }
+
+    BigPoly operator-(const BigPoly& other) const {
+        return *this + -other;
+    }
+
+    BigPoly operator*(const Int& scalar) const {
+        BigPoly result = *this;
+        for (Int& c : result.coeffs)
+            c *= scalar;
+        result.trim();
+        return result;
+    }
+
+    BigPoly operator*(const BigPoly& other) const {
+        if (coeffs.empty() || other.coeffs.empty())
+            return {};
+
+        // Every product coefficient is below min(n, m) * max|a| * max|b|,
+        // and the slots hold twice that.
+        size_t terms = 2 * std::min(coeffs.size(), other.coeffs.size());
+        size_t width = max_limbs() + other.max_limbs() + 1;
+        for (unsigned long long bound = Int::base; bound <= terms; bound *= Int::base)
+            width++;
+
+        Int product = pack(width) * other.pack(width);
+        return unpack(product, width, coeffs.size() + other.coeffs.size() - 1);
+    }
+
+    // The O(n * m) product, for reference.
+    [[nodiscard]] BigPoly schoolbook_multiply(const BigPoly& other) const {
+        if (coeffs.empty() || other.coeffs.empty())
+            return {};
+        std::vector<Int> result(coeffs.size() + other.coeffs.size() - 1);
+        for (size_t i = 0; i < coeffs.size(); ++i) {
+            for (size_t j = 0; j < other.coeffs.size(); ++j)
+                result[i + j] += coeffs[i] * other.coeffs[j];
+        }
+        return BigPoly(std::move(result));
+    }
+
+    BigPoly& operator+=(const BigPoly& other) { return *this = *this + other; }
+    BigPoly& operator-=(const BigPoly& other) { return *this = *this - other; }
+    BigPoly& operator*=(const BigPoly& other) { return *this = *this * other; }
+
+    // Horner's rule.
+    [[nodiscard]] Int evaluate(const Int& x) const {
+        Int result(0);
+        for (size_t i = coeffs.size(); i-- > 0;)
+            result = result * x + coeffs[i];
+        return result;
+    }
+
+    bool operator==(const BigPoly& other) const = default;
+
+    friend std::ostream& operator<<(std::ostream& os, const BigPoly& poly) {
+        os << '[';
+        for (size_t i = 0; i < poly.coeffs.size(); ++i)
+            os << (i > 0 ? ", " : "") << poly.coeffs[i];
+        return os << ']';
+    }
+};
+
+#endif
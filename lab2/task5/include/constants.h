@@ -0,0 +1,141 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_CONSTANTS_H
+#define FUNDAMENTAL_ALGORITHMS_2_CONSTANTS_H
+
+#include "basic_bigint.h"
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <string>
+
+// Seconds spent in every phase of the last digit computation.
+struct DigitTimings {
+    double splitting = 0;
+    double sqrt = 0;
+    double division = 0;
+    double conversion = 0;
+};
+
+namespace constants_detail {
+    constexpr size_t guard_digits = 10;
+
+    inline double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template<typename Int>
+    Int power_of_ten(size_t exponent) {
+        return Int("1" + std::string(exponent, '0'));
+    }
+
+    // "3.1415..." with exactly `digits` digits after the point, from the
+    // value scaled by 10^(digits + guard_digits).
+    template<typename Int>
+    std::string format(const Int& scaled, size_t digits) {
+        std::stringstream ss;
+        ss << scaled;
+        std::string str = ss.str();
+        str.resize(str.size() - guard_digits);
+        return str.substr(0, 1) + "." + str.substr(1, digits);
+    }
+
+    template<typename Int>
+    struct ChudnovskyTerms {
+        Int P, Q, T;
+    };
+
+    // P, Q and T of the Chudnovsky series over the terms [a, b).
+    template<typename Int>
+    ChudnovskyTerms<Int> chudnovsky(long long a, long long b) {
+        if (b - a == 1) {
+            if (a == 0)
+                return {Int(1), Int(1), Int(13591409)};
+            // 640320^3 / 24
+            Int P = Int(6 * a - 5) * Int(2 * a - 1) * Int(6 * a - 1);
+            Int Q = Int(a) * Int(a) * Int(a) * Int("10939058860032000");
+            Int T = P * Int(13591409 + 545140134 * a);
+            return {P, Q, a % 2 ? -T : T};
+        }
+
+        long long m = (a + b) / 2;
+        ChudnovskyTerms<Int> left = chudnovsky<Int>(a, m);
+        ChudnovskyTerms<Int> right = chudnovsky<Int>(m, b);
+        return {left.P * right.P, left.Q * right.Q, left.T * right.Q + left.P * right.T};
+    }
+
+    template<typename Int>
+    struct FactorialTerms {
+        Int P, Q;
+    };
+
+    // P / Q = sum over k in (a, b] of 1 / ((a + 1) * ... * k).
+    template<typename Int>
+    FactorialTerms<Int> factorial_series(long long a, long long b) {
+        if (b - a == 1)
+            return {Int(1), Int(b)};
+
+        long long m = (a + b) / 2;
+        FactorialTerms<Int> left = factorial_series<Int>(a, m);
+        FactorialTerms<Int> right = factorial_series<Int>(m, b);
+        return {left.P * right.Q + right.P, left.Q * right.Q};
+    }
+}
+
+// Digits of pi by the Chudnovsky series with binary splitting. Int should
+// have a subquadratic division policy for large digit counts.
+template<typename Int>
+std::string pi_digits(size_t digits, DigitTimings* timings = nullptr) {
+    using namespace constants_detail;
+    DigitTimings local;
+    DigitTimings& t = timings ? *timings : local;
+    size_t precision = digits + guard_digits;
+
+    auto start = std::chrono::steady_clock::now();
+    // Every term adds about 14.18 digits.
+    auto terms = (long long) ((double) precision / 14.181647462725477) + 2;
+    ChudnovskyTerms<Int> series = chudnovsky<Int>(0, terms);
+    t.splitting = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    Int one = power_of_ten<Int>(precision);
+    Int root = isqrt(Int(10005) * one * one);
+    t.sqrt = seconds_since(start);
+
+    // pi = 426880 * sqrt(10005) * Q / T
+    start = std::chrono::steady_clock::now();
+    Int pi = series.Q * Int(426880) * root / series.T;
+    t.division = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    std::string result = format(pi, digits);
+    t.conversion = seconds_since(start);
+    return result;
+}
+
+// Digits of e = sum 1 / k! with binary splitting. There is no square root.
+template<typename Int>
+std::string e_digits(size_t digits, DigitTimings* timings = nullptr) {
+    using namespace constants_detail;
+    DigitTimings local;
+    DigitTimings& t = timings ? *timings : local;
+    size_t precision = digits + guard_digits;
+
+    auto start = std::chrono::steady_clock::now();
+    long long terms = 1;
+    for (double log_factorial = 0; log_factorial < (double) precision + 2; ++terms)
+        log_factorial += std::log10((double) (terms + 1));
+    FactorialTerms<Int> series = factorial_series<Int>(0, terms);
+    t.splitting = seconds_since(start);
+    t.sqrt = 0;
+
+    // e = 1 + P / Q
+    start = std::chrono::steady_clock::now();
+    Int e = (series.Q + series.P) * power_of_ten<Int>(precision) / series.Q;
+    t.division = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    std::string result = format(e, digits);
+    t.conversion = seconds_since(start);
+    return result;
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_INTERN_POOL_H
+#define FUNDAMENTAL_ALGORITHMS_2_INTERN_POOL_H
+
+#include "basic_bigint.h"
+#include <mutex>
+#include <unordered_set>
+
+template<typename Int>
+class BigIntInternPool;
+
+// A value stored in a BigIntInternPool. Equal values interned in the same
+// pool are the same instance, so equality and hashing look at the address
+// only; ordering still compares values, for tree maps.
+template<typename Int>
+class InternedBigInt {
+    const Int* ptr = nullptr;
+
+    friend class BigIntInternPool<Int>;
+    explicit InternedBigInt(const Int* ptr) : ptr(ptr) {}
+
+public:
+    InternedBigInt() = default;
+
+    [[nodiscard]] const Int& value() const { return *ptr; }
+    const Int& operator*() const { return *ptr; }
+    const Int* operator->() const { return ptr; }
+
+    bool operator==(const InternedBigInt& other) const { return ptr == other.ptr; }
+
+    std::strong_ordering operator<=>(const InternedBigInt& other) const {
+        if (ptr == other.ptr)
+            return std::strong_ordering::equal;
+        return *ptr <=> *other.ptr;
+    }
+};
+
+template<typename Int>
+struct std::hash<InternedBigInt<Int>> {
+    size_t operator()(const InternedBigInt<Int>& value) const noexcept {
+        return std::hash<const Int*>()(&*value);
+    }
+};
+
+// Keeps one copy of every value interned so far. The copies share limbs with
+// the values passed in and have their hashes cached. Handles stay valid until
+// clear() or the pool's destruction; interning is thread-safe.
+template<typename Int>
+class BigIntInternPool {
+    std::unordered_set<Int> values;
+    mutable std::mutex mutex;
+
+public:
+    InternedBigInt<Int> intern(const Int& value) {
+        std::lock_guard lock(mutex);
+        return InternedBigInt<Int>(&*values.insert(value).first);
+    }
+
+    InternedBigInt<Int> intern(Int&& value) {
+        std::lock_guard lock(mutex);
+        return InternedBigInt<Int>(&*values.insert(std::move(value)).first);
+    }
+
+    [[nodiscard]] size_t size() const {
+        std::lock_guard lock(mutex);
+        return values.size();
+    }
+
+    // Invalidates every handle from this pool.
+    void clear() {
+        std::lock_guard lock(mutex);
+        values.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_MODINT_H
+#define FUNDAMENTAL_ALGORITHMS_2_MODINT_H
+
+#include "basic_bigint.h"
+#include <memory>
+#include <numeric>
+#include <utility>
+
+// Everything a modulus needs for fast reduction, computed once and shared by
+// all ModInts over it. Moduli coprime to the base use Montgomery form with
+// R = Base^k; the others keep plain residues and use Barrett reduction.
+template<typename Int>
+class ModContext {
+    Int m;
+    size_t k;
+    bool use_montgomery;
+    Int mu;          // floor(Base^2k / m)
+    Int m_prime;     // -m^-1 mod R
+    Int r_squared;   // R^2 mod m
+
+    static Int low(const Int& x, size_t limbs) {
+        return Int(x, 0, (long) limbs);
+    }
+
+    // x mod m for 0 <= x < Base^2k.
+    Int barrett(const Int& x) const {
+        Int q = (x.shifted(1 - (long) k) * mu).shifted(-1 - (long) k);
+        Int r = x - q * m;
+        while (r >= m)
+            r = r - m;
+        return r;
+    }
+
+    // t / R mod m for 0 <= t < m * R.
+    Int redc(const Int& t) const {
+        Int u = low(low(t, k) * m_prime, k);
+        Int r = (t + u * m).shifted(-(long) k);
+        if (r >= m)
+            r = r - m;
+        return r;
+    }
+
+    // m^-1 mod R by Hensel lifting the inverse modulo one limb.
+    Int inverse_modulo_r() const {
+        long long a = (long long) m.limbs()[0], b = (long long) Int::base, x0 = 1, x1 = 0;
+        while (b != 0) {
+            long long q = a / b;
+            a = std::exchange(b, a - q * b);
+            x0 = std::exchange(x1, x0 - q * x1);
+        }
+        Int x((x0 % (long long) Int::base + (long long) Int::base) % (long long) Int::base);
+
+        for (size_t precision = 1; precision < k;) {
+            precision = std::min(2 * precision, k);
+            Int correction = Int(2) + Int(1).shifted((long) precision) - low(m * x, precision);
+            x = low(x * correction, precision);
+        }
+        return x;
+    }
+
+public:
+    explicit ModContext(Int modulus) : m(std::move(modulus)), k(m.limb_count()) {
+        if (m <= Int(1))
+            throw std::invalid_argument("Modulus must be greater than one");
+
+        Int power = Int(1).shifted(2 * (long) k);
+        mu = power / m;
+        use_montgomery = std::gcd((unsigned long long) m.limbs()[0], (unsigned long long) Int::base) == 1;
+        if (use_montgomery) {
+            m_prime = Int(1).shifted((long) k) - inverse_modulo_r();
+            r_squared = power % m;
+        }
+    }
+
+    [[nodiscard]] const Int& modulus() const { return m; }
+    [[nodiscard]] bool montgomery() const { return use_montgomery; }
+
+    // Any integer into [0, m), with Barrett when it is small enough.
+    [[nodiscard]] Int reduce(const Int& x) const {
+        if (x < Int(0) || x.limb_count() > 2 * k)
+            return x % m;
+        return barrett(x);
+    }
+
+    // Between plain values and the internal representation.
+    [[nodiscard]] Int to_form(const Int& x) const {
+        return use_montgomery ? redc(reduce(x) * r_squared) : reduce(x);
+    }
+
+    [[nodiscard]] Int from_form(const Int& x) const {
+        return use_montgomery ? redc(x) : x;
+    }
+
+    // Product of two reduced values in the internal representation.
+    [[nodiscard]] Int multiply(const Int& a, const Int& b) const {
+        return use_montgomery ? redc(a * b) : barrett(a * b);
+    }
+};
+
+template<typename Int>
+std::shared_ptr<const ModContext<Int>> make_mod_context(const Int& modulus) {
+    return std::make_shared<const ModContext<Int>>(modulus);
+}
+
+// An element of Z/mZ. Sums are not reduced right away: the residue may grow
+// to several multiples of m and is only reduced when a product or a value
+// needs it.
+template<typename Int>
+class ModInt {
+    using Context = ModContext<Int>;
+
+    static constexpr unsigned max_excess = 64;
+
+    std::shared_ptr<const Context> ctx;
+    Int residue;
+    // residue < excess * m
+    unsigned excess = 1;
+
+    ModInt(std::shared_ptr<const Context> context, Int residue, unsigned excess)
+            : ctx(std::move(context)), residue(std::move(residue)), excess(excess) {
+        if (this->excess > max_excess) {
+            this->residue = ctx->reduce(this->residue);
+            this->excess = 1;
+        }
+    }
+
+    [[nodiscard]] Int reduced() const {
+        return excess > 1 ? ctx->reduce(residue) : residue;
+    }
+
+    void check_context(const ModInt& other) const {
+        if (ctx != other.ctx && ctx->modulus() != other.ctx->modulus())
+            throw std::invalid_argument("ModInt moduli differ");
+    }
+
+public:
+    ModInt(std::shared_ptr<const Context> context, const Int& value)
+            : ctx(std::move(context)), residue(ctx->to_form(value)) {}
+
+    [[nodiscard]] const std::shared_ptr<const Context>& context() const { return ctx; }
+
+    // The canonical value in [0, m).
+    [[nodiscard]] Int value() const {
+        return ctx->from_form(reduced());
+    }
+
+    ModInt operator+(const ModInt& other) const {
+        check_context(other);
+        return ModInt(ctx, residue + other.residue, excess + other.excess);
+    }
+
+    ModInt operator-(const ModInt& other) const {
+        check_context(other);
+        Int offset = Int((long long) other.excess) * ctx->modulus();
+        return ModInt(ctx, residue + offset - other.residue, excess + other.excess);
+    }
+
+    ModInt operator*(const ModInt& other) const {
+        check_context(other);
+        return ModInt(ctx, ctx->multiply(reduced(), other.reduced()), 1);
+    }
+
+    // Extended Euclid on the plain value; throws unless gcd(value, m) = 1.
+    [[nodiscard]] ModInt inverse() const {
+        Int a = value(), b = ctx->modulus();
+        Int x0(1), x1(0), zero(0);
+        while (b != zero) {
+            Int q = a / b;
+            a = std::exchange(b, a - q * b);
+            x0 = std::exchange(x1, x0 - q * x1);
+        }
+        if (a != Int(1))
+            throw std::invalid_argument("Value is not invertible");
+        return ModInt(ctx, x0);
+    }
+
+    ModInt operator/(const ModInt& other) const {
+        return *this * other.inverse();
+    }
+
+    // Left to right over the decimal digits of the exponent with a table of
+    // the first ten powers. Negative exponents go through the inverse.
+    [[nodiscard]] ModInt pow(const Int& exponent) const {
+        if (exponent < Int(0))
+            return inverse().pow(-exponent);
+
+        std::vector<ModInt> powers {ModInt(ctx, Int(1)), ModInt(ctx, reduced(), 1)};
+        for (int d = 2; d < 10; ++d)
+            powers.push_back(powers.back() * powers[1]);
+
+        std::stringstream ss;
+        ss << exponent;
+        ModInt result = powers[0];
+        for (char c : ss.str()) {
+            ModInt square = result * result;
+            ModInt fourth = square * square;
+            result = fourth * fourth * square;
+            if (c != '0')
+                result = result * powers[c - '0'];
+        }
+        return result;
+    }
+
+    ModInt& operator+=(const ModInt& other) { return *this = *this + other; }
+    ModInt& operator-=(const ModInt& other) { return *this = *this - other; }
+    ModInt& operator*=(const ModInt& other) { return *this = *this * other; }
+    ModInt& operator/=(const ModInt& other) { return *this = *this / other; }
+
+    bool operator==(const ModInt& other) const {
+        check_context(other);
+        return reduced() == other.reduced();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ModInt& value) {
+        return os << value.value();
+    }
+};
+
+#endif
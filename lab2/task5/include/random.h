@@ -0,0 +1,153 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_RANDOM_H
+#define FUNDAMENTAL_ALGORITHMS_2_RANDOM_H
+
+#include "basic_bigint.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <optional>
+#include <random>
+
+namespace bigint_detail {
+    template<typename Rng>
+    uint64_t random_word(Rng& rng) {
+        if constexpr (Rng::min() == 0 && Rng::max() == ~0ULL)
+            return rng();
+        else
+            return std::uniform_int_distribution<uint64_t>()(rng);
+    }
+
+    // Uniform in [0, bound) by Lemire's multiply-shift, which rejects only
+    // the few words that would bias the result.
+    template<typename Rng>
+    uint64_t random_word_below(uint64_t bound, Rng& rng) {
+        uint128_t product = (uint128_t) random_word(rng) * bound;
+        if ((uint64_t) product < bound) {
+            uint64_t threshold = (0 - bound) % bound;
+            while ((uint64_t) product < threshold)
+                product = (uint128_t) random_word(rng) * bound;
+        }
+        return (uint64_t) (product >> 64);
+    }
+}
+
+// Uniform in [0, bound). The limbs are drawn directly, most significant
+// first; only a draw that ties with the top limb of bound can be rejected,
+// which happens with probability at most 1 / (top limb + 1).
+template<typename Int, typename Rng>
+Int random_below(const Int& bound, Rng& rng) {
+    if (bound <= 0)
+        throw std::invalid_argument("Bound must be positive");
+    const auto& limits = bound.limbs();
+    size_t n = limits.size();
+
+    typename Int::limbs_type limbs(n);
+    while (true) {
+        limbs[n - 1] = bigint_detail::random_word_below(limits[n - 1] + 1, rng);
+        for (size_t i = n - 1; i-- > 0;)
+            limbs[i] = bigint_detail::random_word_below(Int::base, rng);
+        if (limbs[n - 1] < limits[n - 1] ||
+            std::lexicographical_compare(limbs.rbegin(), limbs.rend(), limits.rbegin(), limits.rend()))
+            return Int::from_limbs(std::move(limbs));
+    }
+}
+
+namespace bigint_detail {
+    template<typename Int>
+    Int power_of_two(size_t bits) {
+        Int power(1ULL << (bits % 32));
+        Int square(1ULL << 32);
+        for (size_t e = bits / 32; e > 0; e /= 2) {
+            if (e % 2 == 1)
+                power *= square;
+            if (e > 1)
+                square *= square;
+        }
+        return power;
+    }
+
+    // The top head limbs of 2^bits and its length in limbs, without the
+    // multiplications that the whole power takes. Left-to-right powering on
+    // a few limbs, once rounding down and once up, brackets the power; the
+    // limbs the two brackets share are exact. Returns false in the rare case
+    // that the brackets differ within the head.
+    template<typename Int>
+    bool power_of_two_head(size_t bits, size_t head, typename Int::limbs_type& top, size_t& length) {
+        using limbs_type = typename Int::limbs_type;
+        // The rounding error doubles with each of the log2(bits) squarings;
+        // guard limbs worth 2^70 keep it far below the last head limb.
+        size_t precision = head + 2 + 70 / (size_t) std::log2((double) Int::base);
+
+        auto truncate = [&](Int& x, size_t& exponent, bool up) {
+            const limbs_type& limbs = x.limbs();
+            if (limbs.size() <= precision)
+                return;
+            size_t drop = limbs.size() - precision;
+            bool inexact = std::any_of(limbs.begin(), limbs.begin() + (long) drop, [](auto limb) { return limb != 0; });
+            x = Int::from_limbs(limbs_type(limbs.begin() + (long) drop, limbs.end()));
+            exponent += drop;
+            if (up && inexact)
+                x += 1U;
+        };
+
+        Int low(1U), high(1U);
+        size_t low_exponent = 0, high_exponent = 0;
+        for (size_t mask = std::bit_floor(bits); mask > 0; mask >>= 1) {
+            low *= low;
+            high *= high;
+            low_exponent *= 2;
+            high_exponent *= 2;
+            if (bits & mask) {
+                low *= 2U;
+                high *= 2U;
+            }
+            truncate(low, low_exponent, false);
+            truncate(high, high_exponent, true);
+        }
+
+        const limbs_type& a = low.limbs();
+        const limbs_type& b = high.limbs();
+        length = a.size() + low_exponent;
+        if (b.size() + high_exponent != length)
+            return false;
+        head = std::min(head, a.size());
+        if (b.size() < head || !std::equal(a.end() - (long) head, a.end(), b.end() - (long) head))
+            return false;
+        top.assign(a.end() - (long) head, a.end());
+        return true;
+    }
+}
+
+// Uniform in [0, 2^bits). The draw is random_below(2^bits), but it only
+// needs the top limbs of 2^bits to decide all but about one draw in
+// Base^2; the whole power is computed only for that tie.
+template<typename Int, typename Rng>
+Int random_bits(size_t bits, Rng& rng) {
+    typename Int::limbs_type top;
+    size_t n = 0;
+    if (!bigint_detail::power_of_two_head<Int>(bits, 3, top, n))
+        return random_below(bigint_detail::power_of_two<Int>(bits), rng);
+
+    typename Int::limbs_type limbs(n);
+    std::optional<Int> bound;
+    while (true) {
+        limbs[n - 1] = bigint_detail::random_word_below(top.back() + 1, rng);
+        for (size_t i = n - 1; i-- > 0;)
+            limbs[i] = bigint_detail::random_word_below(Int::base, rng);
+        auto order = std::lexicographical_compare_three_way(limbs.rbegin(), limbs.rbegin() + (long) top.size(),
+                                                            top.rbegin(), top.rend());
+        if (order < 0)
+            return Int::from_limbs(std::move(limbs));
+        if (order == 0) {
+            if (top.size() == n)
+                continue;
+            if (!bound)
+                bound = bigint_detail::power_of_two<Int>(bits);
+            if (std::lexicographical_compare(limbs.rbegin(), limbs.rend(), bound->limbs().rbegin(),
+                                             bound->limbs().rend()))
+                return Int::from_limbs(std::move(limbs));
+        }
+    }
+}
+
+#endif
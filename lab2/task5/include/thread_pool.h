@@ -0,0 +1,167 @@
+#ifndef FUNDAMENTAL_ALGORITHMS_2_THREAD_POOL_H
+#define FUNDAMENTAL_ALGORITHMS_2_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads with one task deque each. Workers take their
+// own newest task first and steal the oldest task of another worker when
+// they run dry; tasks submitted from outside are dealt round robin. A task
+// that is still queued when somebody waits for it runs on the waiting thread
+// instead, so tasks can wait for tasks they submitted without tying up every
+// worker.
+class ThreadPool {
+    struct Task {
+        std::packaged_task<void()> work;
+        std::atomic<bool> claimed {false};
+
+        void run() {
+            if (!claimed.exchange(true))
+                work();
+        }
+    };
+
+    struct Queue {
+        std::deque<std::shared_ptr<Task>> tasks;
+        std::mutex mutex;
+    };
+
+public:
+    class Handle {
+    public:
+        void wait() {
+            task->run();
+            future.get();
+        }
+
+    private:
+        friend class ThreadPool;
+        Handle(std::shared_ptr<Task> task, std::future<void> future)
+                : task(std::move(task)), future(std::move(future)) {}
+
+        std::shared_ptr<Task> task;
+        std::future<void> future;
+    };
+
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+        threads = std::max<size_t>(threads, 1);
+        for (size_t i = 0; i < threads; ++i)
+            queues.push_back(std::make_unique<Queue>());
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back([this, i] { work(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    template<typename F>
+    Handle submit(F&& f) {
+        auto task = std::make_shared<Task>();
+        task->work = std::packaged_task<void()>(std::forward<F>(f));
+        Handle handle(task, task->work.get_future());
+
+        size_t index = current_pool == this ? current_index : next_queue++ % queues.size();
+        {
+            std::lock_guard lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard lock(mutex);
+            pending++;
+        }
+        ready.notify_one();
+        return handle;
+    }
+
+    // Waits for every handle, even after one of them failed, and then
+    // rethrows the first failure.
+    static void wait_all(std::vector<Handle>& handles) {
+        std::exception_ptr failure;
+        for (auto& handle : handles) {
+            try {
+                handle.wait();
+            } catch (...) {
+                if (!failure)
+                    failure = std::current_exception();
+            }
+        }
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+
+    [[nodiscard]] size_t size() const { return workers.size(); }
+
+    // Pool shared by the BigInt kernels, one worker per hardware thread.
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+private:
+    std::shared_ptr<Task> take(size_t index) {
+        for (size_t offset = 0; offset < queues.size(); ++offset) {
+            Queue& queue = *queues[(index + offset) % queues.size()];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            std::shared_ptr<Task> task;
+            if (offset == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            return task;
+        }
+        return nullptr;
+    }
+
+    void work(size_t index) {
+        current_pool = this;
+        current_index = index;
+        while (true) {
+            {
+                std::unique_lock lock(mutex);
+                ready.wait(lock, [this] { return stopping || pending > 0; });
+                if (pending == 0)
+                    return;
+                pending--;
+            }
+            // Every pending count stands for one queued task, so this finds one.
+            if (std::shared_ptr<Task> task = take(index))
+                task->run();
+        }
+    }
+
+    static inline thread_local ThreadPool* current_pool = nullptr;
+    static inline thread_local size_t current_index = 0;
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> next_queue {0};
+    std::mutex mutex;
+    std::condition_variable ready;
+    size_t pending = 0;
+    bool stopping = false;
+};
+
+#endif
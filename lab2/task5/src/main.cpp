@@ -1,3 +1,5 @@
+#include "../include/basic_bigint.h"
+
 int main() {
     return 0;
 }
@@ -0,0 +1,766 @@
+#include "../include/basic_bigint.h"
+#include "../include/accumulator.h"
+#include "../include/batch_mod_exp.h"
+#include "../include/bigfloat.h"
+#include "../include/bigpoly.h"
+#include "../include/constants.h"
+#include "../include/intern_pool.h"
+#include "../include/modint.h"
+#include "../include/random.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <climits>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+template<typename Int>
+class BasicBigIntTest : public ::testing::Test {
+protected:
+    std::mt19937_64 rng {12345};
+
+    Int random(size_t decimal_digits, bool allow_negative = true) {
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::string str;
+        if (allow_negative && rng() % 2)
+            str += '-';
+        str += (char) ('1' + digit(rng) % 9);
+        for (size_t i = 1; i < decimal_digits; ++i)
+            str += (char) ('0' + digit(rng));
+        return Int(str);
+    }
+};
+
+using Variants = ::testing::Types<
+        BasicBigInt<unsigned long long, SchoolbookMultiply, LongDivision>,
+        BasicBigInt<unsigned long long, KaratsubaMultiply, LongDivision>,
+        BasicBigInt<unsigned long long, FftMultiply, LongDivision>,
+        BasicBigInt<unsigned long long, KaratsubaMultiply, LongDivision, 100000>,
+        BasicBigInt<uint32_t, KaratsubaMultiply, LongDivision, 10000>,
+        BasicBigInt<unsigned long long, KaratsubaMultiply, NewtonDivision<>>,
+        BasicBigInt<uint32_t, SchoolbookMultiply, SchoolbookDivision, 10000>,
+        BasicBigInt<unsigned long long, ParallelMultiply<KaratsubaMultiply, 40>, NewtonDivision<>>,
+        BasicBigInt<unsigned long long, SchonhageStrassenMultiply<KaratsubaMultiply, 8>, NewtonDivision<>>,
+        BasicBigInt<unsigned long long, DispatchMultiply<8, 16, 64>, DispatchDivision<8>>>;
+TYPED_TEST_SUITE(BasicBigIntTest, Variants);
+
+TYPED_TEST(BasicBigIntTest, MultiplicationMatchesSchoolbook) {
+    for (size_t digits : {1, 5, 30, 200, 1000, 3000}) {
+        TypeParam a = this->random(digits);
+        TypeParam b = this->random(digits / 2 + 1);
+        TypeParam expected = a.schoolbook_multiply(b);
+        EXPECT_EQ(a * b, expected);
+        EXPECT_EQ(b * a, expected);
+        EXPECT_EQ(a.karatsuba_multiply(b), expected);
+        EXPECT_EQ(a.fft_multiply(b), expected);
+    }
+    EXPECT_EQ(this->random(100) * TypeParam(0), TypeParam(0));
+}
+
+TYPED_TEST(BasicBigIntTest, UnbalancedMultiplication) {
+    TypeParam a = this->random(6000);
+    for (size_t digits : {1, 8, 150, 250, 1400, 2900}) {
+        TypeParam b = this->random(digits);
+        TypeParam expected = a.schoolbook_multiply(b);
+        EXPECT_EQ(a.karatsuba_multiply(b), expected);
+        EXPECT_EQ(b.karatsuba_multiply(a), expected);
+        EXPECT_EQ(a.fft_multiply(b), expected);
+        EXPECT_EQ(b.fft_multiply(a), expected);
+    }
+}
+
+TYPED_TEST(BasicBigIntTest, DivisionIdentity) {
+    for (size_t digits : {1, 7, 25, 60}) {
+        TypeParam a = this->random(digits * 2);
+        TypeParam b = this->random(digits);
+        TypeParam q = a / b;
+        TypeParam r = a % b;
+        EXPECT_GE(r, TypeParam(0));
+        EXPECT_LT(r, b < TypeParam(0) ? -b : b);
+        EXPECT_EQ(a - (a - r) / b * b, r);
+        EXPECT_LE((q < TypeParam(0) ? -q : q) * (b < TypeParam(0) ? -b : b), a < TypeParam(0) ? -a : a);
+    }
+    EXPECT_THROW(TypeParam(5) / TypeParam(0), std::invalid_argument);
+}
+
+TYPED_TEST(BasicBigIntTest, Conversions) {
+    TypeParam value = this->random(500);
+    std::stringstream ss;
+    ss << value;
+    EXPECT_EQ(TypeParam(ss.str()), value);
+    TypeParam parsed;
+    ss >> parsed;
+    EXPECT_EQ(parsed, value);
+
+    std::stringstream binary;
+    value.write_binary(binary);
+    EXPECT_EQ(TypeParam::read_binary(binary), value);
+
+    // Corrupt streams fail as invalid input, not with bad_alloc.
+    std::string bytes = binary.str();
+    auto corrupt = [&](size_t offset, uint64_t word) {
+        std::string copy = bytes;
+        std::memcpy(copy.data() + offset, &word, sizeof(word));
+        std::stringstream stream(copy);
+        return stream;
+    };
+    size_t count_offset = offsetof(BigIntBinaryHeader, limb_count);
+    auto huge = corrupt(count_offset, uint64_t(1) << 40);
+    EXPECT_THROW(TypeParam::read_binary(huge), std::invalid_argument);
+    auto impossible = corrupt(count_offset, ~uint64_t(0));
+    EXPECT_THROW(TypeParam::read_binary(impossible), std::invalid_argument);
+    auto out_of_range = corrupt(sizeof(BigIntBinaryHeader), TypeParam::base);
+    EXPECT_THROW(TypeParam::read_binary(out_of_range), std::invalid_argument);
+
+    EXPECT_EQ(TypeParam("-123456789012345678901234567890"_big), TypeParam("-123456789012345678901234567890"));
+    EXPECT_EQ(TypeParam(std::numeric_limits<long long>::min()), TypeParam("-9223372036854775808"));
+}
+
+TYPED_TEST(BasicBigIntTest, CopiesShareLimbs) {
+    TypeParam a = this->random(300, false);
+    std::stringstream printed;
+    printed << a;
+
+    TypeParam b = a;
+    EXPECT_EQ(b.limbs().data(), a.limbs().data());
+    EXPECT_EQ((-a).limbs().data(), a.limbs().data());
+    EXPECT_EQ((-a).abs().limbs().data(), a.limbs().data());
+    EXPECT_EQ(-(-a), a);
+    EXPECT_EQ((-a).abs(), a);
+    EXPECT_EQ(-TypeParam(0), TypeParam(0));
+
+    b = 7ULL;
+    std::stringstream input("-123");
+    TypeParam c = a;
+    input >> c;
+    EXPECT_EQ(b, TypeParam(7));
+    EXPECT_EQ(c, TypeParam(-123));
+    EXPECT_EQ(a, TypeParam(printed.str()));
+}
+
+TYPED_TEST(BasicBigIntTest, ModExp) {
+    TypeParam mod("1000000007");
+    EXPECT_EQ(mod_exp(TypeParam(2), TypeParam(1000000), mod), TypeParam("235042059"));
+    EXPECT_EQ(mod_exp(TypeParam(123), TypeParam(0), TypeParam(1)), TypeParam(0));
+}
+
+TYPED_TEST(BasicBigIntTest, Accumulator) {
+    BigIntAccumulator<TypeParam> accumulator;
+    TypeParam expected(0);
+    for (size_t i = 0; i < 300; ++i) {
+        TypeParam value = this->random(1 + this->rng() % 80);
+        accumulator += value;
+        expected = expected + value;
+        if (i % 100 == 99) {
+            EXPECT_EQ(accumulator.value(), expected);
+        }
+    }
+    TypeParam last = this->random(90);
+    accumulator -= last;
+    EXPECT_EQ(accumulator.value(), expected - last);
+
+    BigIntAccumulator<TypeParam> negative;
+    negative -= TypeParam("1000000000000");
+    negative += TypeParam(1);
+    EXPECT_EQ(negative.value(), TypeParam("-999999999999"));
+    negative.clear();
+    EXPECT_EQ(negative.value(), TypeParam(0));
+
+    // Dot product with small weights, including the extreme ones.
+    BigIntAccumulator<TypeParam> dot;
+    TypeParam expected_dot(0);
+    long long weights[] = {3, -7, std::numeric_limits<long long>::max(), std::numeric_limits<long long>::min(), 0};
+    for (long long weight : weights) {
+        TypeParam value = this->random(40);
+        dot.multiply_add(value, weight);
+        expected_dot = expected_dot + value * TypeParam(weight);
+    }
+    EXPECT_EQ(dot.value(), expected_dot);
+}
+
+template<typename Int>
+class ModIntTest : public BasicBigIntTest<Int> {};
+
+// LongDivision is too slow for the reference computations here.
+using FastDivisionVariants = ::testing::Types<
+        BasicBigInt<unsigned long long, KaratsubaMultiply, NewtonDivision<>>,
+        BasicBigInt<unsigned long long, FftMultiply, SchoolbookDivision, 100000>,
+        BasicBigInt<uint32_t, SchoolbookMultiply, SchoolbookDivision, 10000>>;
+TYPED_TEST_SUITE(ModIntTest, FastDivisionVariants);
+
+TYPED_TEST(ModIntTest, Arithmetic) {
+    // Prime and 2^127 - 1 take the Montgomery path, the multiples of 2 and 5 Barrett.
+    for (const char* modulus : {"1000000007", "170141183460469231731687303715884105727",
+                                "100000000000000000000000000000000000000000000000000",
+                                "2305843009213693951000000000000000000015"}) {
+        TypeParam m(modulus);
+        auto context = make_mod_context(m);
+        EXPECT_EQ(context->montgomery(), modulus[std::strlen(modulus) - 1] == '7' ||
+                                         modulus[std::strlen(modulus) - 1] == '1');
+
+        TypeParam x = this->random(60), y = this->random(45), z = this->random(30);
+        ModInt<TypeParam> a(context, x), b(context, y), c(context, z);
+        EXPECT_EQ(a.value(), x % m);
+        EXPECT_EQ((a * b).value(), x * y % m);
+        EXPECT_EQ((a + b + c + a + b).value(), (x + y + z + x + y) % m);
+        EXPECT_EQ((a - b - c).value(), (x - y - z) % m);
+        EXPECT_EQ(((a + b) * (b - c) + c).value(), ((x + y) * (y - z) + z) % m);
+        EXPECT_EQ(a.pow(TypeParam(1234567)).value(), mod_exp(x % m, TypeParam(1234567), m));
+        EXPECT_EQ(a.pow(TypeParam(0)).value(), TypeParam(1));
+
+        ModInt<TypeParam> three(context, TypeParam(3));
+        EXPECT_EQ((three * three.inverse()).value(), TypeParam(1));
+        EXPECT_EQ((a / three * three).value(), x % m);
+    }
+
+    auto context = make_mod_context(TypeParam(1000));
+    ModInt<TypeParam> ten(context, TypeParam(10));
+    EXPECT_THROW((void) ten.inverse(), std::invalid_argument);
+    EXPECT_THROW(make_mod_context(TypeParam(1)), std::invalid_argument);
+    EXPECT_THROW(ten + ModInt<TypeParam>(make_mod_context(TypeParam(999)), TypeParam(1)), std::invalid_argument);
+}
+
+TYPED_TEST(ModIntTest, BatchModExp) {
+    TypeParam moduli[] = {TypeParam("1000000007"), TypeParam("340282366920938463463374607431768211456"),
+                          TypeParam("99999999999999999999999999999999999999999999999997")};
+    std::vector<ModExpJob<TypeParam>> jobs;
+    for (size_t i = 0; i < 40; ++i)
+        jobs.push_back({this->random(50), this->random(20, false), moduli[i % 3]});
+    jobs.push_back({TypeParam(5), TypeParam(3), TypeParam(1)});
+
+    ThreadPool pool(3);
+    BatchLatency latency;
+    std::vector<TypeParam> results = batch_mod_exp(std::span<const ModExpJob<TypeParam>>(jobs), &latency, pool);
+    ASSERT_EQ(results.size(), jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i)
+        EXPECT_EQ(results[i], mod_exp(jobs[i].base, jobs[i].exponent, jobs[i].modulus));
+
+    EXPECT_LE(latency.p50, latency.p90);
+    EXPECT_LE(latency.p90, latency.p99);
+    EXPECT_LE(latency.p99, latency.max);
+    EXPECT_GT(latency.total, 0);
+
+    jobs.push_back({TypeParam(5), TypeParam(3), TypeParam(0)});
+    EXPECT_THROW(batch_mod_exp(std::span<const ModExpJob<TypeParam>>(jobs)), std::invalid_argument);
+}
+
+TEST(ThreadPoolTest, NestedTasks) {
+    ThreadPool pool(2);
+    std::atomic<int> count {0};
+    std::vector<ThreadPool::Handle> outer;
+    for (int i = 0; i < 8; ++i) {
+        outer.push_back(pool.submit([&] {
+            std::vector<ThreadPool::Handle> inner;
+            for (int j = 0; j < 8; ++j)
+                inner.push_back(pool.submit([&] { count++; }));
+            ThreadPool::wait_all(inner);
+        }));
+    }
+    ThreadPool::wait_all(outer);
+    EXPECT_EQ(count, 64);
+
+    std::vector<ThreadPool::Handle> failing;
+    failing.push_back(pool.submit([] { throw std::runtime_error("task failed"); }));
+    failing.push_back(pool.submit([&] { count++; }));
+    EXPECT_THROW(ThreadPool::wait_all(failing), std::runtime_error);
+    EXPECT_EQ(count, 65);
+}
+
+TYPED_TEST(BasicBigIntTest, SquareRoot) {
+    for (size_t digits : {1, 2, 15, 40, 120}) {
+        TypeParam n = this->random(digits, false);
+        TypeParam root = isqrt(n);
+        EXPECT_LE(root * root, n);
+        EXPECT_GT((root + TypeParam(1)) * (root + TypeParam(1)), n);
+    }
+    EXPECT_EQ(isqrt(TypeParam(0)), TypeParam(0));
+    EXPECT_EQ(isqrt(TypeParam("1000000000000000000000000")), TypeParam("1000000000000"));
+    EXPECT_THROW(isqrt(TypeParam(-4)), std::invalid_argument);
+}
+
+TYPED_TEST(BasicBigIntTest, MixedWidthArithmetic) {
+    std::mt19937_64 word_rng(31);
+    for (size_t digits : {1, 3, 8, 25, 60}) {
+        for (int iteration = 0; iteration < 10; ++iteration) {
+            TypeParam a = this->random(digits);
+            unsigned long long u = iteration % 2 ? word_rng() : word_rng() % 1000;
+            long long s = (long long) (word_rng() % 2000000) - 1000000;
+            TypeParam big_u(std::to_string(u)), big_s(s);
+
+            EXPECT_EQ(a + u, a + big_u);
+            EXPECT_EQ(a - u, a - big_u);
+            EXPECT_EQ(a * u, a * big_u);
+            EXPECT_EQ(a + s, a + big_s);
+            EXPECT_EQ(s - a, big_s - a);
+            EXPECT_EQ(a * s, a * big_s);
+            if (u != 0) {
+                EXPECT_EQ(a / u, a / big_u);
+                EXPECT_EQ(TypeParam(a % u), a % big_u);
+            }
+            if (s != 0) {
+                EXPECT_EQ(a / s, a / big_s);
+                EXPECT_EQ(TypeParam(a % s), a % big_s);
+            }
+            EXPECT_EQ(a <=> s, a <=> big_s);
+            EXPECT_EQ(a == u, a == big_u);
+        }
+    }
+
+    TypeParam x(999999999);
+    const auto* buffer = x.limbs().data();
+    x += 1;
+    x -= 2;
+    x *= 3;
+    x /= 3;
+    EXPECT_EQ(x, 999999998);
+    EXPECT_EQ(x.limbs().data(), buffer);
+    EXPECT_EQ(TypeParam(5) - 7, -2);
+    EXPECT_EQ(TypeParam(-5) + 7u, 2);
+    EXPECT_THROW(x /= 0, std::invalid_argument);
+}
+
+TYPED_TEST(BasicBigIntTest, MachineConversions) {
+    using bigint_detail::int128_t;
+    using bigint_detail::uint128_t;
+    auto int128_max = (int128_t) (~(uint128_t) 0 >> 1);
+    auto int128_min = -int128_max - 1;
+
+    EXPECT_EQ((int128_t) TypeParam(int128_max), int128_max);
+    EXPECT_EQ((int128_t) TypeParam(int128_min), int128_min);
+    EXPECT_EQ((uint128_t) TypeParam(~(uint128_t) 0), ~(uint128_t) 0);
+    EXPECT_EQ((long long) TypeParam(LLONG_MIN), LLONG_MIN);
+    EXPECT_EQ((unsigned long long) TypeParam(ULLONG_MAX), ULLONG_MAX);
+    EXPECT_EQ((int) TypeParam(-123456), -123456);
+    EXPECT_THROW((void) (int) TypeParam(1LL << 40), std::out_of_range);
+    EXPECT_THROW((void) (unsigned) TypeParam(-1), std::out_of_range);
+    EXPECT_THROW((void) (int128_t) (TypeParam(int128_max) + 1), std::out_of_range);
+
+    std::mt19937_64 word_rng(17);
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        double value = std::ldexp((double) (word_rng() >> 11), (int) (word_rng() % 900) - 20);
+        value = iteration % 2 ? -std::trunc(value) : std::trunc(value);
+        EXPECT_EQ((double) TypeParam(value), value);
+    }
+    EXPECT_EQ(TypeParam(-2.9), -2);
+    EXPECT_EQ(TypeParam(1e30), TypeParam("1000000000000000019884624838656"));
+    EXPECT_THROW(TypeParam(std::nan("")), std::invalid_argument);
+
+    // 2^53 + 1 is a tie and rounds to even; one more unit anywhere below
+    // breaks the tie upwards.
+    TypeParam tie = TypeParam(1ULL << 53) + 1;
+    EXPECT_EQ((double) tie, 9007199254740992.0);
+    EXPECT_EQ((double) (tie * (1ULL << 20)), std::ldexp(1.0, 73));
+    EXPECT_EQ((double) (tie * (1ULL << 20) + 1), std::ldexp(9007199254740994.0, 20));
+    EXPECT_EQ((double) -(tie * (1ULL << 20) - 1), -std::ldexp(1.0, 73));
+    EXPECT_EQ((double) TypeParam(std::string(400, '9')), HUGE_VAL);
+}
+
+TYPED_TEST(BasicBigIntTest, Hashing) {
+    std::hash<TypeParam> hasher;
+    for (size_t digits : {1, 7, 30, 200}) {
+        TypeParam a = this->random(digits);
+        std::stringstream ss;
+        ss << a;
+        TypeParam parsed(ss.str());
+        EXPECT_EQ(hasher(a), hasher(parsed));
+        EXPECT_EQ(hasher(a), hasher(TypeParam(a)));
+        EXPECT_NE(hasher(a), hasher(-a));
+        EXPECT_NE(hasher(a), hasher(a + 1));
+        EXPECT_EQ(hasher(-(-a)), hasher(a));
+
+        // The cached hash follows mutations in place.
+        TypeParam b = a;
+        (void) b.hash();
+        b += 1;
+        EXPECT_EQ(hasher(b), hasher(a + 1));
+        b -= 1;
+        EXPECT_EQ(b, a);
+        EXPECT_EQ(hasher(b), hasher(a));
+    }
+    EXPECT_EQ(hasher(TypeParam(0)), hasher(-TypeParam(0)));
+
+    std::unordered_set<size_t> seen;
+    for (int i = 0; i < 2000; ++i)
+        seen.insert(hasher(TypeParam(i) * 1000003));
+    EXPECT_EQ(seen.size(), 2000u);
+
+    std::unordered_map<TypeParam, int> cache;
+    for (int i = 0; i < 100; ++i)
+        cache[TypeParam(i).shifted(i % 7)] = i;
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(cache.at(TypeParam(i).shifted(i % 7)), i);
+}
+
+TEST(BinaryTest, MappedFileRejectsOutOfRangeLimbs) {
+    using Int = BasicBigInt<unsigned long long, KaratsubaMultiply, SchoolbookDivision, 1000000>;
+    std::string path = ::testing::TempDir() + "bigint_mapped.bin";
+    save_binary(Int("123456789012345678"), path);
+    EXPECT_EQ(MappedBigInt(path).view().size(), 3);
+
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    unsigned long long limb = 1000000;
+    file.seekp(sizeof(BigIntBinaryHeader));
+    file.write(reinterpret_cast<const char*>(&limb), sizeof(limb));
+    file.close();
+    EXPECT_THROW(MappedBigInt mapped(path), std::invalid_argument);
+    EXPECT_THROW(load_binary<Int>(path), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST(InternPoolTest, DeduplicatesValues) {
+    using Int = BasicBigInt<unsigned long long, KaratsubaMultiply, NewtonDivision<>>;
+    BigIntInternPool<Int> pool;
+    Int big(std::string(500, '7'));
+
+    auto first = pool.intern(big);
+    auto second = pool.intern(Int(std::string(500, '7')));
+    auto other = pool.intern(big + 1);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(&*first, &*second);
+    EXPECT_NE(first, other);
+    EXPECT_LT(first, other);
+    EXPECT_EQ(first.value(), big);
+    EXPECT_EQ(first->limbs().data(), big.limbs().data());
+    EXPECT_EQ(pool.size(), 2u);
+
+    std::map<InternedBigInt<Int>, int> tree {{other, 2}, {first, 1}};
+    EXPECT_EQ(tree.begin()->second, 1);
+    std::unordered_map<InternedBigInt<Int>, int> table {{first, 1}, {other, 2}};
+    EXPECT_EQ(table.at(second), 1);
+
+    std::vector<InternedBigInt<Int>> handles(8);
+    std::vector<std::thread> threads;
+    for (auto& handle : handles)
+        threads.emplace_back([&] { handle = pool.intern(Int(std::string(300, '3'))); });
+    for (auto& thread : threads)
+        thread.join();
+    for (const auto& handle : handles)
+        EXPECT_EQ(&*handle, &*handles[0]);
+    EXPECT_EQ(pool.size(), 3u);
+}
+
+TYPED_TEST(BasicBigIntTest, PolynomialProduct) {
+    using Poly = BigPoly<TypeParam>;
+    auto random_poly = [&](size_t terms, size_t digits) {
+        std::vector<TypeParam> coefficients;
+        for (size_t i = 0; i < terms; ++i)
+            coefficients.push_back(this->rng() % 5 == 0 ? TypeParam(0) : this->random(1 + this->rng() % digits));
+        return Poly(std::move(coefficients));
+    };
+
+    std::pair<size_t, size_t> shapes[] = {{1, 1}, {1, 9}, {5, 5}, {17, 40}, {60, 3}};
+    for (auto [n, m] : shapes) {
+        for (size_t digits : {1, 12, 50}) {
+            Poly a = random_poly(n, digits), b = random_poly(m, digits);
+            Poly expected = a.schoolbook_multiply(b);
+            EXPECT_EQ(a * b, expected);
+            EXPECT_EQ(b * a, expected);
+            TypeParam x(-37);
+            EXPECT_EQ(expected.evaluate(x), a.evaluate(x) * b.evaluate(x));
+        }
+    }
+
+    // Coefficients at exactly half a slot and runs of full slots exercise
+    // the borrow between slots.
+    TypeParam nines(std::string(18, '9'));
+    Poly extreme {nines, -nines, nines, -nines};
+    EXPECT_EQ(extreme * extreme, extreme.schoolbook_multiply(extreme));
+    std::vector<TypeParam> telescoped(41, TypeParam(0));
+    telescoped[0] = TypeParam(-1);
+    telescoped[40] = TypeParam(1);
+    Poly x_minus_one {TypeParam(-1), TypeParam(1)}, geometric(std::vector<TypeParam>(40, TypeParam(1)));
+    EXPECT_EQ(x_minus_one * geometric, Poly(telescoped));
+    EXPECT_EQ((extreme - extreme).degree(), -1);
+    EXPECT_EQ((extreme * Poly()).degree(), -1);
+}
+
+TYPED_TEST(BasicBigIntTest, RandomGeneration) {
+    std::mt19937_64 gen(5);
+    for (size_t digits : {1, 6, 7, 40}) {
+        for (TypeParam bound : {this->random(digits, false), TypeParam(1).shifted((long) digits)}) {
+            for (int i = 0; i < 50; ++i) {
+                TypeParam value = random_below(bound, gen);
+                EXPECT_GE(value, 0);
+                EXPECT_LT(value, bound);
+            }
+        }
+    }
+    EXPECT_EQ(random_below(TypeParam(1), gen), 0);
+    EXPECT_THROW(random_below(TypeParam(-3), gen), std::invalid_argument);
+    EXPECT_EQ(random_bits<TypeParam>(0, gen), 0);
+
+    // Every residue of a small bound shows up about equally often.
+    std::vector<int> counts(7);
+    for (int i = 0; i < 7000; ++i)
+        counts[(size_t) random_below(TypeParam(7), gen)]++;
+    for (int count : counts)
+        EXPECT_NEAR(count, 1000, 150);
+
+    TypeParam limit = TypeParam(1ULL << 36) * TypeParam(1ULL << 40);
+    int high = 0;
+    for (int i = 0; i < 400; ++i) {
+        TypeParam value = random_bits<TypeParam>(76, gen);
+        EXPECT_LT(value, limit);
+        high += value * 2 >= limit;
+    }
+    EXPECT_NEAR(high, 200, 50);
+}
+
+TYPED_TEST(BasicBigIntTest, PowerOfTwoHead) {
+    // The head random_bits draws against has to match the whole power.
+    for (size_t bits = 0; bits < 8000; bits += bits < 700 ? 1 : 331) {
+        TypeParam power = bigint_detail::power_of_two<TypeParam>(bits);
+        const auto& limbs = power.limbs();
+        typename TypeParam::limbs_type top;
+        size_t length = 0;
+        ASSERT_TRUE(bigint_detail::power_of_two_head<TypeParam>(bits, 3, top, length)) << bits;
+        ASSERT_EQ(length, limbs.size()) << bits;
+        ASSERT_EQ(top.size(), std::min<size_t>(3, limbs.size())) << bits;
+        EXPECT_TRUE(std::equal(top.begin(), top.end(), limbs.end() - (long) top.size())) << bits;
+    }
+}
+
+TEST(FftTest, PackedMatchesKaratsuba) {
+    using Packed = BasicBigInt<unsigned long long, BasicFftMultiply<true>, LongDivision>;
+    using Unpacked = BasicBigInt<unsigned long long, BasicFftMultiply<false>, LongDivision>;
+    std::mt19937_64 rng(99);
+    auto random_digits = [&](size_t n) {
+        std::string str(1, '9');
+        for (size_t i = 1; i < n; ++i)
+            str += (char) ('0' + rng() % 10);
+        return str;
+    };
+
+    for (size_t digits : {6, 100, 5000, 40000}) {
+        std::string a = random_digits(digits), b = random_digits(digits - 3);
+        Packed expected = Packed(a).karatsuba_multiply(Packed(b));
+        EXPECT_EQ(Packed(a) * Packed(b), expected);
+        std::stringstream unpacked, packed;
+        unpacked << Unpacked(a) * Unpacked(b);
+        packed << expected;
+        EXPECT_EQ(unpacked.str(), packed.str());
+    }
+}
+
+TEST(FftTest, TablesAreSharedAcrossThreads) {
+    using Int = BasicBigInt<unsigned long long, FftMultiply, LongDivision>;
+    Int a(std::string(3000, '7')), b(std::string(2900, '3'));
+    Int expected = a.karatsuba_multiply(b);
+
+    std::vector<Int> results(8);
+    std::vector<std::thread> threads;
+    for (auto& result : results)
+        threads.emplace_back([&] { result = a * b; });
+    for (auto& thread : threads)
+        thread.join();
+    for (const auto& result : results)
+        EXPECT_EQ(result, expected);
+}
+
+TEST(ParallelMultiplyTest, MatchesSerial) {
+    using Serial = BasicBigInt<unsigned long long, KaratsubaMultiply, LongDivision>;
+    using Parallel = BasicBigInt<unsigned long long, ParallelMultiply<FftMultiply, 256>, LongDivision>;
+    std::mt19937_64 rng(2024);
+    auto random_digits = [&](size_t n) {
+        std::string str(1, '1');
+        for (size_t i = 1; i < n; ++i)
+            str += (char) ('0' + rng() % 10);
+        return str;
+    };
+
+    std::pair<size_t, size_t> shapes[] = {{60000, 60000}, {60000, 35000}, {90000, 2000}, {2000, 90000}};
+    for (auto [n, m] : shapes) {
+        std::string a = random_digits(n), b = random_digits(m);
+        std::stringstream serial, parallel;
+        serial << Serial(a) * Serial(b);
+        parallel << Parallel(a) * Parallel(b);
+        EXPECT_EQ(parallel.str(), serial.str());
+    }
+}
+
+TEST(SchonhageStrassenTest, MatchesKaratsuba) {
+    using Karatsuba = BasicBigInt<unsigned long long, KaratsubaMultiply, LongDivision>;
+    using Ssa = BasicBigInt<unsigned long long, SchonhageStrassenMultiply<FftMultiply, 256>, LongDivision>;
+    using SmallBase = BasicBigInt<uint32_t, SchonhageStrassenMultiply<KaratsubaMultiply, 64>, LongDivision, 10000>;
+    using Dispatch = BasicBigInt<unsigned long long, DispatchMultiply<8, 32, 128>, LongDivision>;
+    std::mt19937_64 rng(4040);
+    auto random_digits = [&](size_t n, char first) {
+        std::string str(1, first);
+        for (size_t i = 1; i < n; ++i)
+            str += (char) ('0' + rng() % 10);
+        return str;
+    };
+    auto str = [](const auto& value) {
+        std::stringstream ss;
+        ss << value;
+        return ss.str();
+    };
+
+    std::pair<size_t, size_t> shapes[] = {{500, 500}, {3000, 2990}, {20000, 700}, {900, 45000}, {60000, 60000}};
+    for (auto [n, m] : shapes) {
+        // All nines push every coefficient of the convolution to its bound.
+        for (char first : {'1', '9'}) {
+            std::string a = first == '9' ? std::string(n, '9') : random_digits(n, first);
+            std::string b = first == '9' ? std::string(m, '9') : random_digits(m, first);
+            std::string expected = str(Karatsuba(a) * Karatsuba(b));
+            EXPECT_EQ(str(Ssa(a) * Ssa(b)), expected);
+            EXPECT_EQ(str(SmallBase(a) * SmallBase(b)), expected);
+            EXPECT_EQ(str(Dispatch(a) * Dispatch(-Dispatch(b))), "-" + expected);
+        }
+    }
+}
+
+TEST(NewtonDivisionTest, MatchesSchoolbook) {
+    using Newton = BasicBigInt<unsigned long long, KaratsubaMultiply, NewtonDivision<>>;
+    using Schoolbook = BasicBigInt<unsigned long long, KaratsubaMultiply, SchoolbookDivision>;
+    std::mt19937_64 rng(777);
+    auto str = [](const auto& value) {
+        std::stringstream ss;
+        ss << value;
+        return ss.str();
+    };
+    auto random_digits = [&](size_t n, char first) {
+        std::string str(1, first);
+        for (size_t i = 1; i < n; ++i)
+            str += (char) ('0' + rng() % 10);
+        return str;
+    };
+
+    std::pair<size_t, size_t> shapes[] = {{3000, 1000}, {3000, 2700}, {6000, 300}, {1200, 600}, {4000, 1990}};
+    for (auto [n, m] : shapes) {
+        for (char first : {'1', '9'}) {
+            std::string a = random_digits(n, '9'), b = random_digits(m, first);
+            EXPECT_EQ(str(Newton(a) / Newton(b)), str(Schoolbook(a) / Schoolbook(b)));
+            EXPECT_EQ(str(Newton(a) % Newton(b)), str(Schoolbook(a) % Schoolbook(b)));
+        }
+        // Divisors just below a power of the base push every estimate to its edge.
+        std::string nines(m, '9');
+        Newton a(random_digits(n, '9')), b(nines);
+        Newton q = a / b, r = a % b;
+        EXPECT_EQ(q * b + r, a);
+        EXPECT_LT(r, b);
+    }
+}
+
+TEST(BigFloatTest, Rounding) {
+    using Float = BigFloat<BasicBigInt<unsigned long long, KaratsubaMultiply, NewtonDivision<>>>;
+    auto str = [](const Float& value) {
+        std::stringstream ss;
+        ss << value;
+        return ss.str();
+    };
+
+    EXPECT_EQ(str(Float("1", 10) / Float("3", 10)), "0.3333333333");
+    EXPECT_EQ(str(Float("2", 5) / Float("-3", 5)), "-0.66667");
+    EXPECT_EQ(str(Float("1", 2) / Float("8", 2)), "0.12");
+    EXPECT_EQ(str(Float("1", 2) / Float("7.9", 2)), "0.13");
+    EXPECT_EQ(str(Float("2.5", 1)), "2");
+    EXPECT_EQ(str(Float("3.5", 1)), "4");
+    EXPECT_EQ(str(Float("-2.5", 1)), "-2");
+    EXPECT_EQ(str(Float("2.50001", 1)), "3");
+    EXPECT_EQ(str(Float("1.5e-400", 5) * Float("2e400", 5)), "3");
+    EXPECT_EQ(str(Float("12345e1000", 3)), "1.23e1004");
+
+    EXPECT_EQ(str(sqrt(Float("2"))), "1.4142135623730950488016887242096980785696718753769");
+    EXPECT_EQ(str(sqrt(Float("0.0004"))), "0.02");
+    EXPECT_THROW(sqrt(Float("-1")), std::invalid_argument);
+    EXPECT_THROW(Float("1") / Float("0"), std::invalid_argument);
+
+    // Far below the last place a term only decides the rounding.
+    EXPECT_EQ(str(Float("1", 5) + Float("1e-100", 5)), "1");
+    EXPECT_EQ(str(Float("1.0001", 5) - Float("5e-5", 5)), "1");
+    EXPECT_EQ(str(Float("1.0001", 5) - Float("5.0000001e-5", 8)), "1.00005");
+    EXPECT_LT(Float("1", 5) - Float("1e-100", 200), Float("1", 5));
+    EXPECT_EQ(Float("1e-100", 5) + Float("1", 5) - Float("1", 5), Float("0"));
+}
+
+TEST(BigFloatTest, ErrorStaysWithinHalfAnUlp) {
+    using Int = BasicBigInt<unsigned long long, KaratsubaMultiply, NewtonDivision<>>;
+    using Float = BigFloat<Int>;
+    const size_t exact = 2000;
+    std::mt19937_64 rng(42);
+    auto random_float = [&](size_t digits, size_t precision) {
+        std::string str(1, (char) ('1' + rng() % 9));
+        for (size_t i = 1; i < digits; ++i)
+            str += (char) ('0' + rng() % 10);
+        return Float(str + "e" + std::to_string((long) (rng() % 41) - 20), precision);
+    };
+    // Half of one unit in the last of precision digits of x, held exactly.
+    auto half_ulp = [&](const Float& x, size_t precision) {
+        std::stringstream ss;
+        ss << x.mantissa().abs();
+        long top = x.exponent() + (long) ss.str().size() - 1;
+        return Float(Int(5), top - (long) precision, exact);
+    };
+
+    for (size_t precision : {1, 7, 30, 120}) {
+        for (int iteration = 0; iteration < 20; ++iteration) {
+            Float a = random_float(1 + rng() % 150, precision), b = random_float(1 + rng() % 150, precision);
+
+            Float q = a / b;
+            EXPECT_LE((q.with_precision(exact) * b - a).abs(), half_ulp(q, precision) * b);
+
+            Float r = sqrt(a).with_precision(exact);
+            Float low = r - half_ulp(r, precision), high = r + half_ulp(r, precision);
+            EXPECT_LE(low * low, a);
+            EXPECT_GE(high * high, a);
+        }
+    }
+}
+
+TEST(BigFloatTest, FixedPoint) {
+    using Float = BigFloat<BasicBigInt<uint32_t, SchoolbookMultiply, SchoolbookDivision, 10000>>;
+    auto str = [](const Float& value) {
+        std::stringstream ss;
+        ss << value;
+        return ss.str();
+    };
+
+    EXPECT_EQ(str(Float("2.675").quantize(2)), "2.68");
+    EXPECT_EQ(str(Float("2.665").quantize(2)), "2.66");
+    EXPECT_EQ(str(Float("-2.665").quantize(2)), "-2.66");
+    EXPECT_EQ(str(Float("999.995").quantize(2)), "1000");
+    EXPECT_EQ(str(Float("0.004").quantize(2)), "0");
+    EXPECT_EQ(str(Float("0.005").quantize(2)), "0");
+    EXPECT_EQ(str(Float("0.0051").quantize(2)), "0.01");
+    EXPECT_EQ(str(Float("-0.0051").quantize(2)), "-0.01");
+    EXPECT_EQ(str(Float("12.3").quantize(2)), "12.3");
+
+    Float total("0");
+    for (int i = 0; i < 10; ++i)
+        total += Float("0.1");
+    EXPECT_EQ(total, Float("1"));
+    EXPECT_EQ(str(Float("1234567.891", 30) * Float("0.0725", 30)), "89506.1720975");
+}
+
+TEST(ConstantsTest, FirstDigits) {
+    using Int = BasicBigInt<unsigned long long, KaratsubaMultiply, NewtonDivision<>>;
+    std::string pi = "3.14159265358979323846264338327950288419716939937510"
+                     "58209749445923078164062862089986280348253421170679";
+    std::string e = "2.71828182845904523536028747135266249775724709369995"
+                    "95749669676277240766303535475945713821785251664274";
+
+    EXPECT_EQ(pi_digits<Int>(100), pi);
+    EXPECT_EQ(e_digits<Int>(100), e);
+    EXPECT_EQ(pi_digits<Int>(1), "3.1");
+
+    DigitTimings timings;
+    std::string long_pi = pi_digits<Int>(5000, &timings);
+    EXPECT_EQ(long_pi.size(), 5002);
+    EXPECT_EQ(long_pi.substr(0, pi.size()), pi);
+    // Digits 4991..5000 of pi.
+    EXPECT_EQ(long_pi.substr(4992), "4132604721");
+    EXPECT_GT(timings.division, 0);
+    EXPECT_EQ(e_digits<Int>(5000).substr(0, e.size()), e);
+}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -2,6 +2,8 @@
 #define FUNDAMENTAL_ALGORITHMS_2_BST_H
 
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <stack>
 #include <cassert>
 
@@ -10,7 +12,9 @@ struct DefaultComparator {
     bool operator()(const T& a, const T& b) const { return a < b; }
 };
 
-template <typename Key, typename Value, typename Comparator = DefaultComparator<Key>>
+// Nodes come from Allocator rebound to the node type, as in std::map.
+template <typename Key, typename Value, typename Comparator = DefaultComparator<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
 class BST {
     struct Node {
         Key key;
@@ -22,16 +26,42 @@ class BST {
                 : key(k), value(v), left(nullptr), right(nullptr) {}
     };
 
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
     Node* root;
     size_t tree_size;
     Comparator cmp;
+    [[no_unique_address]] NodeAllocator alloc;
+
+    Node* create_node(const Key& key, const Value& value) {
+        Node* node = NodeTraits::allocate(alloc, 1);
+        try {
+            NodeTraits::construct(alloc, node, key, value);
+        } catch (...) {
+            NodeTraits::deallocate(alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroy_node(Node* node) {
+        NodeTraits::destroy(alloc, node);
+        NodeTraits::deallocate(alloc, node, 1);
+    }
+
 public:
+    using allocator_type = Allocator;
+
     BST() : root(nullptr), tree_size(0) {}
+    explicit BST(const Allocator& allocator) : root(nullptr), tree_size(0), alloc(allocator) {}
     ~BST() { clear(); }
 
+    allocator_type get_allocator() const { return Allocator(alloc); }
+
     void insert(const Key& key, const Value& value) {
         if (!root) {
-            root = new Node(key, value);
+            root = create_node(key, value);
             tree_size++;
             return;
         }
@@ -51,7 +81,7 @@ public:
             }
         }
 
-        Node* newNode = new Node(key, value);
+        Node* newNode = create_node(key, value);
         if (cmp(key, parent->key)) {
             parent->left = newNode;
         } else {
@@ -103,7 +133,7 @@ public:
                 parent->right = child;
             }
 
-            delete current;
+            destroy_node(current);
         } else {
             Node* successor_parent = current;
             Node* next = current->right;
@@ -122,7 +152,7 @@ public:
                 successor_parent->right = next->right;
             }
 
-            delete next;
+            destroy_node(next);
         }
 
         tree_size--;
@@ -143,7 +173,7 @@ public:
             if (node->right)
                 stack.push(node->right);
 
-            delete node;
+            destroy_node(node);
         }
 
         root = nullptr;
@@ -266,6 +296,9 @@ public:
     Iterator end() { return Iterator(); }
 };
 
+template <typename Key, typename Value, typename Comparator = DefaultComparator<Key>>
+using PmrBST = BST<Key, Value, Comparator, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
 template <typename Key,
         typename Value,
         template<typename, typename, typename> class TreeType,
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <string>
+#include <memory_resource>
 
 TEST(BSTTest, InsertAndSize) {
     MyMap<int, std::string, BST> map;
@@ -114,6 +115,23 @@ TEST(BSTTest, Iterator) {
     EXPECT_EQ(it, map.end());
 }
 
+TEST(BSTTest, PmrTreeStaysOnItsResource) {
+    std::byte buffer[8192];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof buffer, std::pmr::null_memory_resource());
+
+    PmrBST<int, int> tree(&resource);
+    for (int i = 0; i < 100; ++i)
+        tree.insert((i * 37) % 100, i);
+    EXPECT_EQ(tree.size(), 100);
+    EXPECT_TRUE(tree.remove(37));
+    EXPECT_EQ(*tree.find(74), 2);
+    EXPECT_EQ(tree.get_allocator().resource(), &resource);
+
+    MyMap<int, int, PmrBST> map;
+    map.insert(1, 2);
+    EXPECT_EQ(*map.find(1), 2);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();